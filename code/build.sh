@@ -0,0 +1,9 @@
+#!/bin/sh
+
+CompilerFlags="-O2 -ffast-math -msse2 -w"
+LinkerFlags="-lX11 -lXext -lpthread"
+
+mkdir -p ../build
+cd ../build
+
+c++ $CompilerFlags ../code/linux_pixeleditor.cpp -o linux_pixeleditor $LinkerFlags
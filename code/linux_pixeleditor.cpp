@@ -0,0 +1,981 @@
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/keysym.h>
+#include <X11/XKBlib.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdlib.h>
+#include <time.h>
+
+// NOTE(rick): Normally comes from wingdi.h, the bitmap code only needs the
+// value.
+#define BI_RGB 0
+
+#include "pixeleditor.cpp"
+#include "pixeleditor_timing.cpp"
+#include "linux_pixeleditor.h"
+
+static bool32 GlobalRunning;
+static struct frame_timing GlobalFrameTiming;
+static bool32 GlobalWriteTimingTrace;
+static struct linux_work_queue GlobalWorkQueue;
+static bool32 GlobalSharedMemoryFailed;
+
+inline static uint64
+LinuxGetWallClock()
+{
+	struct timespec Now = {0};
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	uint64 Result = ((uint64)Now.tv_sec * 1000000000ull) + (uint64)Now.tv_nsec;
+	return(Result);
+}
+
+inline static real32
+LinuxGetSecondsElapsed(uint64 Start, uint64 End)
+{
+	real32 Result = (real32)((real64)(End - Start) / 1000000000.0);
+	return(Result);
+}
+
+// NOTE(rick): Event times are the server's CLOCK_MONOTONIC in milliseconds,
+// which on a local display is the same clock as ours. Anything that doesn't
+// line up with now, like a remote server, is treated as having just arrived.
+inline static uint64
+LinuxGetEventTimestamp(Time EventTime)
+{
+	uint64 Result = LinuxGetWallClock();
+	uint64 NowMS = Result / 1000000;
+	uint64 EventMS = (NowMS & ~0xFFFFFFFFull) | (uint64)(uint32)EventTime;
+	if(EventMS > NowMS)
+	{
+		EventMS -= 0x100000000ull;
+	}
+	uint64 AgeMS = NowMS - EventMS;
+	if(AgeMS < 1000)
+	{
+		Result -= AgeMS * 1000000;
+	}
+	return(Result);
+}
+
+static int
+LinuxSharedMemoryErrorHandler(Display *XDisplay, XErrorEvent *Event)
+{
+	GlobalSharedMemoryFailed = true;
+	return(0);
+}
+
+static void
+LinuxFreeOffscreenBuffer(Display *XDisplay, struct linux_offscreen_buffer *Offscreen)
+{
+	if(Offscreen->Image)
+	{
+		// NOTE(rick): XDestroyImage would free the pixels as well, they are
+		// ours to release.
+		Offscreen->Image->data = 0;
+		XDestroyImage(Offscreen->Image);
+		Offscreen->Image = 0;
+	}
+
+	if(Offscreen->Memory)
+	{
+		if(Offscreen->UsingSharedMemory)
+		{
+			XShmDetach(XDisplay, &Offscreen->SegmentInfo);
+			XSync(XDisplay, False);
+			shmdt(Offscreen->SegmentInfo.shmaddr);
+		}
+		else
+		{
+			free(Offscreen->Memory);
+		}
+		Offscreen->Memory = 0;
+	}
+	Offscreen->CapacityBytes = 0;
+	Offscreen->UsingSharedMemory = false;
+}
+
+static bool32
+LinuxAllocateSharedMemory(Display *XDisplay, struct linux_offscreen_buffer *Offscreen, uint32 Size)
+{
+	if(!XShmQueryExtension(XDisplay))
+	{
+		return(false);
+	}
+
+	Offscreen->SegmentInfo.shmid = shmget(IPC_PRIVATE, Size, IPC_CREAT | 0600);
+	if(Offscreen->SegmentInfo.shmid < 0)
+	{
+		return(false);
+	}
+
+	Offscreen->SegmentInfo.shmaddr = (char *)shmat(Offscreen->SegmentInfo.shmid, 0, 0);
+	if(Offscreen->SegmentInfo.shmaddr == (char *)-1)
+	{
+		shmctl(Offscreen->SegmentInfo.shmid, IPC_RMID, 0);
+		return(false);
+	}
+	Offscreen->SegmentInfo.readOnly = False;
+
+	// NOTE(rick): Attaching fails asynchronously on displays that can't see our
+	// memory, e.g. over the network.
+	GlobalSharedMemoryFailed = false;
+	XErrorHandler OldHandler = XSetErrorHandler(LinuxSharedMemoryErrorHandler);
+	XShmAttach(XDisplay, &Offscreen->SegmentInfo);
+	XSync(XDisplay, False);
+	XSetErrorHandler(OldHandler);
+
+	// NOTE(rick): Marked for removal straight away, it goes once both sides
+	// have detached, even if we crash.
+	shmctl(Offscreen->SegmentInfo.shmid, IPC_RMID, 0);
+	if(GlobalSharedMemoryFailed)
+	{
+		shmdt(Offscreen->SegmentInfo.shmaddr);
+		return(false);
+	}
+
+	Offscreen->Memory = Offscreen->SegmentInfo.shmaddr;
+	return(true);
+}
+
+// NOTE(rick): Called once per frame with the latest window size rather than
+// for every ConfigureNotify. Memory is only replaced when the new size doesn't
+// fit; otherwise just the image header is rebuilt around the same pixels.
+static void
+LinuxResizeScreenBuffer(Display *XDisplay, Visual *XVisual, int32 Depth,
+						struct linux_offscreen_buffer *Offscreen, struct game_screen_buffer *Buffer,
+						uint32 Width, uint32 Height)
+{
+	if(Width == 0) { Width = 1; }
+	if(Height == 0) { Height = 1; }
+
+	uint32 BytesPerPixel = 4;
+	uint32 Size = Width * Height * BytesPerPixel;
+	if(Size > Offscreen->CapacityBytes)
+	{
+		LinuxFreeOffscreenBuffer(XDisplay, Offscreen);
+
+		uint32 Granularity = LINUX_SCREEN_BUFFER_GRANULARITY;
+		uint32 CapacityWidth = ((Width + Granularity - 1) / Granularity) * Granularity;
+		uint32 CapacityHeight = ((Height + Granularity - 1) / Granularity) * Granularity;
+		uint32 Capacity = CapacityWidth * CapacityHeight * BytesPerPixel;
+
+		Offscreen->UsingSharedMemory = LinuxAllocateSharedMemory(XDisplay, Offscreen, Capacity);
+		if(!Offscreen->UsingSharedMemory)
+		{
+			Offscreen->Memory = calloc(1, Capacity);
+		}
+		Offscreen->CapacityBytes = Offscreen->Memory ? Capacity : 0;
+	}
+	else if(Offscreen->Image)
+	{
+		Offscreen->Image->data = 0;
+		XDestroyImage(Offscreen->Image);
+		Offscreen->Image = 0;
+	}
+
+	// NOTE(rick): A taller, narrower window can fit in the same pixel memory,
+	// so the row hashes are sized from the height on their own.
+	if(Height > Offscreen->RowHashCapacity)
+	{
+		if(Offscreen->RowHashes)
+		{
+			free(Offscreen->RowHashes);
+		}
+		uint32 Granularity = LINUX_SCREEN_BUFFER_GRANULARITY;
+		uint32 CapacityHeight = ((Height + Granularity - 1) / Granularity) * Granularity;
+		Offscreen->RowHashes = (uint64 *)calloc(CapacityHeight, sizeof(uint64));
+		Offscreen->RowHashCapacity = Offscreen->RowHashes ? CapacityHeight : 0;
+	}
+
+	if(!Offscreen->Memory || !Offscreen->RowHashes)
+	{
+		Buffer->BitmapMemory = 0;
+		return;
+	}
+
+	if(Offscreen->UsingSharedMemory)
+	{
+		Offscreen->Image = XShmCreateImage(XDisplay, XVisual, Depth, ZPixmap,
+										   (char *)Offscreen->Memory, &Offscreen->SegmentInfo, Width, Height);
+	}
+	else
+	{
+		Offscreen->Image = XCreateImage(XDisplay, XVisual, Depth, ZPixmap, 0,
+										(char *)Offscreen->Memory, Width, Height, 32, Width * BytesPerPixel);
+	}
+
+	Buffer->BitmapMemory = Offscreen->Memory;
+	Buffer->Width = Width;
+	Buffer->Height = Height;
+	Buffer->BytesPerPixel = BytesPerPixel;
+	Buffer->Pitch = Offscreen->Image ? Offscreen->Image->bytes_per_line : (Width * BytesPerPixel);
+	Offscreen->NeedsFullPresent = true;
+}
+
+static uint64
+LinuxHashScreenRow(uint32 *Row, uint32 Count)
+{
+	uint64 Lanes[2] = {0x9e3779b97f4a7c15, 0xc2b2ae3d27d4eb4f};
+	uint64 *Words = (uint64 *)Row;
+	uint32 WordCount = Count / 2;
+	uint32 WordIndex = 0;
+	for(; WordIndex + 2 <= WordCount; WordIndex += 2)
+	{
+		for(int32 Lane = 0; Lane < 2; ++Lane)
+		{
+			Lanes[Lane] ^= Words[WordIndex + Lane];
+			Lanes[Lane] *= 0xff51afd7ed558ccd;
+			Lanes[Lane] ^= (Lanes[Lane] >> 32);
+		}
+	}
+	for(uint32 Index = WordIndex * 2; Index < Count; ++Index)
+	{
+		Lanes[0] ^= Row[Index];
+		Lanes[0] *= 0xff51afd7ed558ccd;
+		Lanes[0] ^= (Lanes[0] >> 32);
+	}
+
+	uint64 Result = Lanes[0] ^ (Lanes[1] + 0x9e3779b97f4a7c15 + (Lanes[0] << 6) + (Lanes[0] >> 2));
+	return(Result);
+}
+
+// NOTE(rick): The editor redraws the whole buffer every frame, so the rows
+// that actually changed are found by hashing them against the last present.
+// Only the band between the first and last changed row is handed to the
+// server, which copies it out of the shared segment itself.
+static void
+LinuxDisplayBufferInWindow(Display *XDisplay, Window XWindow, GC Context,
+						   struct linux_offscreen_buffer *Offscreen, struct game_screen_buffer *Buffer)
+{
+	if(!Offscreen->Image || ((uint32)Buffer->Height > Offscreen->RowHashCapacity))
+	{
+		return;
+	}
+
+	int32 MinY = Buffer->Height;
+	int32 MaxY = -1;
+	for(int32 Y = 0; Y < Buffer->Height; ++Y)
+	{
+		uint32 *Row = (uint32 *)((uint8 *)Buffer->BitmapMemory + (Y * Buffer->Pitch));
+		uint64 Hash = LinuxHashScreenRow(Row, Buffer->Width);
+		if(Offscreen->NeedsFullPresent || (Hash != Offscreen->RowHashes[Y]))
+		{
+			Offscreen->RowHashes[Y] = Hash;
+			if(Y < MinY) { MinY = Y; }
+			MaxY = Y;
+		}
+	}
+	Offscreen->NeedsFullPresent = false;
+
+	if(MaxY >= MinY)
+	{
+		uint32 Rows = (MaxY - MinY) + 1;
+		if(Offscreen->UsingSharedMemory)
+		{
+			XShmPutImage(XDisplay, XWindow, Context, Offscreen->Image,
+						 0, MinY, 0, MinY, Buffer->Width, Rows, False);
+		}
+		else
+		{
+			XPutImage(XDisplay, XWindow, Context, Offscreen->Image,
+					  0, MinY, 0, MinY, Buffer->Width, Rows);
+		}
+
+		// NOTE(rick): The server reads the segment after we return, so wait for
+		// it to finish before the next frame draws over it.
+		XSync(XDisplay, False);
+	}
+}
+
+static void
+LinuxProcessInputMessage(struct input_button_state *Button, bool32 IsDown)
+{
+	if(Button->EndedDown != IsDown)
+	{
+		Button->EndedDown = IsDown;
+		++Button->HalfTransitionCount;
+	}
+
+	if(Button->EndedDown)
+	{
+		Button->Tapped = true;
+	}
+}
+
+// NOTE(rick): Same bindings as the win32 layer.
+static void
+LinuxProcessKey(struct app_input *Input, KeySym Key, bool32 IsDown, bool32 ControlIsDown)
+{
+	switch(Key)
+	{
+		case XK_s:
+		{
+			LinuxProcessInputMessage(ControlIsDown ? &Input->ButtonExportSpriteSheet : &Input->ButtonSave, IsDown);
+		} break;
+		case XK_r: { LinuxProcessInputMessage(&Input->ButtonReset, IsDown); } break;
+		case XK_e:
+		{
+			LinuxProcessInputMessage(ControlIsDown ? &Input->ButtonExportScaled : &Input->ButtonEraser, IsDown);
+		} break;
+		case XK_q: { LinuxProcessInputMessage(&Input->ButtonQuickSwitch, IsDown); } break;
+		case XK_p: { LinuxProcessInputMessage(&Input->ButtonEyeDropper, IsDown); } break;
+		case XK_1: { LinuxProcessInputMessage(&Input->ButtonSize1, IsDown); } break;
+		case XK_2: { LinuxProcessInputMessage(&Input->ButtonSize2, IsDown); } break;
+		case XK_3: { LinuxProcessInputMessage(&Input->ButtonSize3, IsDown); } break;
+		case XK_4: { LinuxProcessInputMessage(&Input->ButtonSize4, IsDown); } break;
+		case XK_5: { LinuxProcessInputMessage(&Input->ButtonSize5, IsDown); } break;
+		case XK_6: { LinuxProcessInputMessage(&Input->ButtonSize6, IsDown); } break;
+		case XK_b: { LinuxProcessInputMessage(&Input->ButtonToolPencil, IsDown); } break;
+		case XK_m: { LinuxProcessInputMessage(&Input->ButtonToolRectangleSelect, IsDown); } break;
+		case XK_l: { LinuxProcessInputMessage(&Input->ButtonToolLassoSelect, IsDown); } break;
+		case XK_i: { LinuxProcessInputMessage(&Input->ButtonToolLine, IsDown); } break;
+		case XK_u: { LinuxProcessInputMessage(&Input->ButtonToolRectangle, IsDown); } break;
+		case XK_y: { LinuxProcessInputMessage(&Input->ButtonToolEllipse, IsDown); } break;
+		case XK_f: { LinuxProcessInputMessage(&Input->ButtonToggleShapeFill, IsDown); } break;
+		case XK_g: { LinuxProcessInputMessage(&Input->ButtonToolGradient, IsDown); } break;
+		case XK_d: { LinuxProcessInputMessage(&Input->ButtonToggleGradientDither, IsDown); } break;
+		case XK_k: { LinuxProcessInputMessage(&Input->ButtonCycleGradientSteps, IsDown); } break;
+		case XK_w: { LinuxProcessInputMessage(&Input->ButtonReplaceColor, IsDown); } break;
+		case XK_a:
+		{
+			if(!ControlIsDown)
+			{
+				LinuxProcessInputMessage(&Input->ButtonSwapPalette, IsDown);
+			}
+		} break;
+		case XK_t: { LinuxProcessInputMessage(&Input->ButtonCycleTolerance, IsDown); } break;
+		case XK_z:
+		{
+			LinuxProcessInputMessage(ControlIsDown ? &Input->ButtonUndo : &Input->ButtonCycleReferenceMode, IsDown);
+		} break;
+		case XK_v:
+		{
+			LinuxProcessInputMessage(ControlIsDown ? &Input->ButtonPaste : &Input->ButtonToolMove, IsDown);
+		} break;
+		case XK_c:
+		{
+			if(ControlIsDown)
+			{
+				LinuxProcessInputMessage(&Input->ButtonCopy, IsDown);
+			}
+		} break;
+		case XK_x:
+		{
+			LinuxProcessInputMessage(ControlIsDown ? &Input->ButtonCut : &Input->ButtonToggleWrap, IsDown);
+		} break;
+		case XK_Delete:
+		{
+			LinuxProcessInputMessage(ControlIsDown ? &Input->ButtonDeleteFrame : &Input->ButtonDelete, IsDown);
+		} break;
+		case XK_Return:
+		case XK_Escape: { LinuxProcessInputMessage(&Input->ButtonDeselect, IsDown); } break;
+		case XK_bracketright: { LinuxProcessInputMessage(&Input->ButtonRotateClockwise, IsDown); } break;
+		case XK_bracketleft: { LinuxProcessInputMessage(&Input->ButtonRotateCounterClockwise, IsDown); } break;
+		case XK_backslash: { LinuxProcessInputMessage(&Input->ButtonRotateHalf, IsDown); } break;
+		case XK_h: { LinuxProcessInputMessage(&Input->ButtonFlipHorizontal, IsDown); } break;
+		case XK_j: { LinuxProcessInputMessage(&Input->ButtonFlipVertical, IsDown); } break;
+		case XK_equal:
+		{
+			LinuxProcessInputMessage(ControlIsDown ? &Input->ButtonReferenceScaleUp : &Input->ButtonScaleUp, IsDown);
+		} break;
+		case XK_minus:
+		{
+			LinuxProcessInputMessage(ControlIsDown ? &Input->ButtonReferenceScaleDown : &Input->ButtonScaleDown, IsDown);
+		} break;
+		case XK_n: { LinuxProcessInputMessage(&Input->ButtonAddFrame, IsDown); } break;
+		case XK_comma: { LinuxProcessInputMessage(&Input->ButtonPreviousFrame, IsDown); } break;
+		case XK_period: { LinuxProcessInputMessage(&Input->ButtonNextFrame, IsDown); } break;
+		case XK_space: { LinuxProcessInputMessage(&Input->ButtonPlayAnimation, IsDown); } break;
+		case XK_o:
+		{
+			LinuxProcessInputMessage(ControlIsDown ? &Input->ButtonLoadReference : &Input->ButtonOnionSkin, IsDown);
+		} break;
+		case XK_Prior:
+		{
+			LinuxProcessInputMessage(ControlIsDown ? &Input->ButtonReferenceOpacityUp : &Input->ButtonIncreaseFPS, IsDown);
+		} break;
+		case XK_Next:
+		{
+			LinuxProcessInputMessage(ControlIsDown ? &Input->ButtonReferenceOpacityDown : &Input->ButtonDecreaseFPS, IsDown);
+		} break;
+		case XK_Left: { LinuxProcessInputMessage(&Input->ButtonReferenceLeft, IsDown); } break;
+		case XK_Right: { LinuxProcessInputMessage(&Input->ButtonReferenceRight, IsDown); } break;
+		case XK_Up: { LinuxProcessInputMessage(&Input->ButtonReferenceUp, IsDown); } break;
+		case XK_Down: { LinuxProcessInputMessage(&Input->ButtonReferenceDown, IsDown); } break;
+		case XK_F12:
+		{
+			if(IsDown)
+			{
+				GlobalWriteTimingTrace = true;
+			}
+		} break;
+		default: {} break;
+	}
+}
+
+// NOTE(rick): Mouse buttons are tracked from events rather than polled, so
+// their state lives here between frames. Key repeats are dropped by comparing
+// against KeysDown, the same job lParam bit 30 does on win32.
+static void
+LinuxProcessPendingMessages(Display *XDisplay, Atom DeleteWindowAtom, struct app_input *Input,
+							bool32 *KeysDown, uint32 *WindowWidth, uint32 *WindowHeight,
+							struct linux_offscreen_buffer *Offscreen)
+{
+	while(XPending(XDisplay))
+	{
+		XEvent Event = {0};
+		XNextEvent(XDisplay, &Event);
+
+		switch(Event.type)
+		{
+			case ClientMessage:
+			{
+				if((Atom)Event.xclient.data.l[0] == DeleteWindowAtom)
+				{
+					GlobalRunning = false;
+				}
+			} break;
+			case DestroyNotify:
+			{
+				GlobalRunning = false;
+			} break;
+			case ConfigureNotify:
+			{
+				*WindowWidth = Event.xconfigure.width;
+				*WindowHeight = Event.xconfigure.height;
+			} break;
+			case Expose:
+			{
+				Offscreen->NeedsFullPresent = true;
+			} break;
+			case KeyPress:
+			case KeyRelease:
+			{
+				RecordInputEvent(&GlobalFrameTiming, LinuxGetEventTimestamp(Event.xkey.time));
+				bool32 IsDown = (Event.type == KeyPress);
+				uint32 KeyCode = Event.xkey.keycode & 0xff;
+				if(KeysDown[KeyCode] != IsDown)
+				{
+					KeysDown[KeyCode] = IsDown;
+					bool32 ControlIsDown = ((Event.xkey.state & ControlMask) != 0);
+					LinuxProcessKey(Input, XLookupKeysym(&Event.xkey, 0), IsDown, ControlIsDown);
+				}
+			} break;
+			case ButtonPress:
+			case ButtonRelease:
+			{
+				RecordInputEvent(&GlobalFrameTiming, LinuxGetEventTimestamp(Event.xbutton.time));
+				bool32 IsDown = (Event.type == ButtonPress);
+				Input->MouseX = Event.xbutton.x;
+				Input->MouseY = Event.xbutton.y;
+				switch(Event.xbutton.button)
+				{
+					case Button1: { LinuxProcessInputMessage(&Input->ButtonPrimary, IsDown); } break;
+					case Button3: { LinuxProcessInputMessage(&Input->ButtonSecondary, IsDown); } break;
+					// NOTE(rick): One wheel notch, in the units win32 reports.
+					case Button4: { if(IsDown) { Input->MouseWheelScrollDirection = 120; } } break;
+					case Button5: { if(IsDown) { Input->MouseWheelScrollDirection = -120; } } break;
+					default: {} break;
+				}
+			} break;
+			case MotionNotify:
+			{
+				RecordInputEvent(&GlobalFrameTiming, LinuxGetEventTimestamp(Event.xmotion.time));
+				Input->MouseX = Event.xmotion.x;
+				Input->MouseY = Event.xmotion.y;
+			} break;
+			default: {} break;
+		}
+	}
+}
+
+PLATFORM_READ_ENTIRE_FILE(LinuxReadEntireFile)
+{
+	struct platform_file_contents Result = {0};
+
+	int File = open(Filename, O_RDONLY);
+	if(File >= 0)
+	{
+		struct stat FileStatus = {0};
+		if((fstat(File, &FileStatus) == 0) && (FileStatus.st_size > 0) && (FileStatus.st_size <= 0xFFFFFFFF))
+		{
+			uint32 Size = (uint32)FileStatus.st_size;
+			void *Data = calloc(1, Size);
+			if(Data)
+			{
+				uint32 BytesRead = 0;
+				while(BytesRead < Size)
+				{
+					ssize_t Count = read(File, (uint8 *)Data + BytesRead, Size - BytesRead);
+					if(Count <= 0)
+					{
+						break;
+					}
+					BytesRead += (uint32)Count;
+				}
+
+				if(BytesRead == Size)
+				{
+					Result.Data = Data;
+					Result.Size = Size;
+				}
+				else
+				{
+					free(Data);
+				}
+			}
+		}
+
+		close(File);
+	}
+
+	return(Result);
+}
+
+PLATFORM_MAP_FILE(LinuxMapFile)
+{
+	struct platform_file_contents Result = {0};
+
+	int File = open(Filename, O_RDONLY);
+	if(File >= 0)
+	{
+		struct stat FileStatus = {0};
+		if((fstat(File, &FileStatus) == 0) && (FileStatus.st_size > 0) && (FileStatus.st_size <= 0xFFFFFFFF))
+		{
+			void *Data = mmap(0, FileStatus.st_size, PROT_READ, MAP_PRIVATE, File, 0);
+			if(Data != MAP_FAILED)
+			{
+				Result.Data = Data;
+				Result.Size = (uint32)FileStatus.st_size;
+			}
+		}
+
+		// NOTE(rick): The mapping stays valid after the descriptor is closed.
+		close(File);
+	}
+
+	return(Result);
+}
+
+PLATFORM_UNMAP_FILE(LinuxUnmapFile)
+{
+	if(Memory)
+	{
+		munmap(Memory, Size);
+	}
+}
+
+static bool32
+LinuxWriteAll(int File, void *Data, uint32 Size)
+{
+	uint32 BytesWritten = 0;
+	while(BytesWritten < Size)
+	{
+		ssize_t Count = write(File, (uint8 *)Data + BytesWritten, Size - BytesWritten);
+		if(Count <= 0)
+		{
+			break;
+		}
+		BytesWritten += (uint32)Count;
+	}
+
+	bool32 Result = (BytesWritten == Size);
+	return(Result);
+}
+
+PLATFORM_WRITE_FILE(LinuxWriteFile)
+{
+	bool32 Result = false;
+
+	int File = open(Filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(File >= 0)
+	{
+		Result = LinuxWriteAll(File, Data, Size);
+		close(File);
+	}
+
+	return(Result);
+}
+
+PLATFORM_WRITE_FILE_RANGES(LinuxWriteFileRanges)
+{
+	bool32 Result = false;
+
+	int File = open(Filename, O_WRONLY);
+	if(File >= 0)
+	{
+		struct stat FileStatus = {0};
+		if((fstat(File, &FileStatus) == 0) && ((uint64)FileStatus.st_size == ExpectedFileSize))
+		{
+			Result = true;
+			for(uint32 RangeIndex = 0; RangeIndex < RangeCount; ++RangeIndex)
+			{
+				struct platform_file_range *Range = Ranges + RangeIndex;
+				ssize_t Count = pwrite(File, Range->Data, Range->Size, (off_t)Range->Offset);
+				if(Count != (ssize_t)Range->Size)
+				{
+					Result = false;
+					break;
+				}
+			}
+		}
+
+		close(File);
+	}
+
+	return(Result);
+}
+
+PLATFORM_BEGIN_WRITE_FILE(LinuxBeginWriteFile)
+{
+	void *Result = 0;
+
+	int File = open(Filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(File >= 0)
+	{
+		// NOTE(rick): Stored off by one so descriptor 0 isn't mistaken for a
+		// failure.
+		Result = (void *)(intptr_t)(File + 1);
+	}
+
+	return(Result);
+}
+
+PLATFORM_APPEND_TO_FILE(LinuxAppendToFile)
+{
+	bool32 Result = LinuxWriteAll((int)((intptr_t)File - 1), Data, Size);
+	return(Result);
+}
+
+PLATFORM_END_WRITE_FILE(LinuxEndWriteFile)
+{
+	bool32 Result = (close((int)((intptr_t)File - 1)) == 0);
+	return(Result);
+}
+
+PLATFORM_ALLOCATE_MEMORY(LinuxAllocateMemory)
+{
+	void *Result = calloc(1, Size);
+	return(Result);
+}
+
+PLATFORM_FREE_MEMORY(LinuxFreeMemory)
+{
+	if(Memory)
+	{
+		free(Memory);
+	}
+}
+
+static void
+LinuxDoQueuedJobs(struct linux_work_queue *Queue)
+{
+	for(;;)
+	{
+		int32 JobIndex = __sync_fetch_and_add(&Queue->NextJob, 1);
+		if(JobIndex >= Queue->JobCount)
+		{
+			break;
+		}
+
+		Queue->Callback(Queue->Context, (uint32)JobIndex);
+		__sync_fetch_and_add(&Queue->CompletedJobs, 1);
+	}
+}
+
+static void *
+LinuxWorkerThreadProc(void *Parameter)
+{
+	struct linux_work_queue *Queue = (struct linux_work_queue *)Parameter;
+	for(;;)
+	{
+		while(sem_wait(&Queue->Semaphore) != 0) {}
+		LinuxDoQueuedJobs(Queue);
+		__sync_fetch_and_add(&Queue->WorkersCheckedIn, 1);
+	}
+	return(0);
+}
+
+static void
+LinuxInitializeWorkQueue(struct linux_work_queue *Queue)
+{
+	long ProcessorCount = sysconf(_SC_NPROCESSORS_ONLN);
+	uint32 WorkerCount = 0;
+	if(ProcessorCount > 1)
+	{
+		WorkerCount = (uint32)ProcessorCount - 1;
+	}
+	if(WorkerCount > LINUX_MAX_WORKER_THREADS)
+	{
+		WorkerCount = LINUX_MAX_WORKER_THREADS;
+	}
+
+	Queue->NextJob = 0;
+	Queue->JobCount = 0;
+	if(sem_init(&Queue->Semaphore, 0, 0) == 0)
+	{
+		for(uint32 WorkerIndex = 0; WorkerIndex < WorkerCount; ++WorkerIndex)
+		{
+			pthread_t Thread;
+			if(pthread_create(&Thread, 0, LinuxWorkerThreadProc, Queue) != 0)
+			{
+				break;
+			}
+			pthread_detach(Thread);
+			++Queue->WorkerCount;
+		}
+	}
+}
+
+PLATFORM_RUN_PARALLEL(LinuxRunParallel)
+{
+	struct linux_work_queue *Queue = &GlobalWorkQueue;
+	uint32 WorkersToWake = JobCount - 1;
+	if(WorkersToWake > Queue->WorkerCount)
+	{
+		WorkersToWake = Queue->WorkerCount;
+	}
+
+	if((JobCount == 0) || (WorkersToWake == 0))
+	{
+		for(uint32 JobIndex = 0; JobIndex < JobCount; ++JobIndex)
+		{
+			Callback(Context, JobIndex);
+		}
+		return;
+	}
+
+	Queue->Callback = Callback;
+	Queue->Context = Context;
+	Queue->JobCount = (int32)JobCount;
+	Queue->CompletedJobs = 0;
+	Queue->WorkersCheckedIn = 0;
+	__sync_synchronize();
+	__sync_lock_test_and_set(&Queue->NextJob, 0);
+	for(uint32 WorkerIndex = 0; WorkerIndex < WorkersToWake; ++WorkerIndex)
+	{
+		sem_post(&Queue->Semaphore);
+	}
+
+	LinuxDoQueuedJobs(Queue);
+	while((Queue->CompletedJobs < (int32)JobCount) ||
+		  (Queue->WorkersCheckedIn < (int32)WorkersToWake))
+	{
+		_mm_pause();
+	}
+	__sync_synchronize();
+}
+
+// NOTE(rick): "--frames N" quits after N frames, for running headless under
+// Xvfb in automated tests. Those runs leave the working directory alone: no
+// session is restored or saved, and the timing summary goes to stderr instead
+// of FrameTiming.json.
+int
+main(int ArgCount, char **Args)
+{
+	uint32 FrameLimit = 0;
+	for(int ArgIndex = 1; ArgIndex < ArgCount; ++ArgIndex)
+	{
+		if((strcmp(Args[ArgIndex], "--frames") == 0) && (ArgIndex + 1 < ArgCount))
+		{
+			FrameLimit = (uint32)atoi(Args[++ArgIndex]);
+		}
+	}
+
+	Display *XDisplay = XOpenDisplay(0);
+	if(!XDisplay)
+	{
+		fprintf(stderr, "Failed to open the X display.\n");
+		return 1;
+	}
+
+	int Screen = DefaultScreen(XDisplay);
+	XVisualInfo VisualInfo = {0};
+	if(!XMatchVisualInfo(XDisplay, Screen, 24, TrueColor, &VisualInfo) ||
+	   (VisualInfo.red_mask != 0xff0000) || (VisualInfo.green_mask != 0x00ff00) || (VisualInfo.blue_mask != 0x0000ff))
+	{
+		fprintf(stderr, "No 24-bit TrueColor visual with an XRGB layout.\n");
+		XCloseDisplay(XDisplay);
+		return 2;
+	}
+
+	uint32 WindowWidth = 860;
+	uint32 WindowHeight = 900;
+	Window RootWindow = RootWindow(XDisplay, Screen);
+	XSetWindowAttributes WindowAttributes = {0};
+	WindowAttributes.colormap = XCreateColormap(XDisplay, RootWindow, VisualInfo.visual, AllocNone);
+	WindowAttributes.background_pixel = 0;
+	WindowAttributes.border_pixel = 0;
+	WindowAttributes.event_mask = (StructureNotifyMask | ExposureMask |
+								   KeyPressMask | KeyReleaseMask |
+								   ButtonPressMask | ButtonReleaseMask | PointerMotionMask);
+	Window XWindow = XCreateWindow(XDisplay, RootWindow, 0, 0, WindowWidth, WindowHeight, 0,
+								   VisualInfo.depth, InputOutput, VisualInfo.visual,
+								   CWColormap | CWBackPixel | CWBorderPixel | CWEventMask, &WindowAttributes);
+	if(!XWindow)
+	{
+		fprintf(stderr, "Failed to create window.\n");
+		XCloseDisplay(XDisplay);
+		return 2;
+	}
+
+	XStoreName(XDisplay, XWindow, "Pixel Editor");
+	Atom DeleteWindowAtom = XInternAtom(XDisplay, "WM_DELETE_WINDOW", False);
+	XSetWMProtocols(XDisplay, XWindow, &DeleteWindowAtom, 1);
+	XkbSetDetectableAutoRepeat(XDisplay, True, 0);
+	XMapWindow(XDisplay, XWindow);
+	GC Context = XCreateGC(XDisplay, XWindow, 0, 0);
+
+	struct game_screen_buffer ScreenBuffer = {0};
+	struct linux_offscreen_buffer Offscreen = {0};
+	LinuxResizeScreenBuffer(XDisplay, VisualInfo.visual, VisualInfo.depth, &Offscreen, &ScreenBuffer,
+							WindowWidth, WindowHeight);
+	if(!ScreenBuffer.BitmapMemory)
+	{
+		fprintf(stderr, "Failed to allocate the screen buffer.\n");
+		XCloseDisplay(XDisplay);
+		return 2;
+	}
+	uint32 BufferWidth = WindowWidth;
+	uint32 BufferHeight = WindowHeight;
+
+	struct app_input Input[2] = {0};
+	struct app_input *NewInput = &Input[0];
+	struct app_input *OldInput = &Input[1];
+	bool32 KeysDown[256] = {0};
+
+	struct app_state AppState = {0};
+	AppState.PlatformReadEntireFile = LinuxReadEntireFile;
+	AppState.PlatformMapFile = LinuxMapFile;
+	AppState.PlatformUnmapFile = LinuxUnmapFile;
+	AppState.PlatformWriteFile = LinuxWriteFile;
+	AppState.PlatformWriteFileRanges = LinuxWriteFileRanges;
+	AppState.PlatformBeginWriteFile = LinuxBeginWriteFile;
+	AppState.PlatformAppendToFile = LinuxAppendToFile;
+	AppState.PlatformEndWriteFile = LinuxEndWriteFile;
+	AppState.PlatformAllocateMemory = LinuxAllocateMemory;
+	AppState.PlatformFreeMemory = LinuxFreeMemory;
+	AppState.SessionDisabled = (FrameLimit != 0);
+
+	LinuxInitializeWorkQueue(&GlobalWorkQueue);
+	if(GlobalWorkQueue.WorkerCount > 0)
+	{
+		AppState.PlatformRunParallel = LinuxRunParallel;
+	}
+
+	GlobalFrameTiming.Frequency = 1000000000ull;
+	// NOTE(rick): X event times are whole milliseconds.
+	GlobalFrameTiming.InputClockResolutionMS = 1.0;
+
+	GlobalRunning = true;
+	real32 TargetFPS = 60.0f;
+	real32 TargetSecondsPerFrame = 1.0f / TargetFPS;
+	real32 TargetMSPerFrame = TargetSecondsPerFrame * 1000.0f;
+	real32 LastFrameMS = 0.0f;
+	real32 LastUpdateMS = 0.0f;
+	uint32 FramesRun = 0;
+	while(GlobalRunning)
+	{
+		uint64 StartTime = LinuxGetWallClock();
+		BeginFrameTiming(&GlobalFrameTiming, StartTime);
+
+		*NewInput = {0};
+		NewInput->dtForFrame = TargetSecondsPerFrame;
+		NewInput->LastFrameMS = LastFrameMS;
+		NewInput->LastUpdateMS = LastUpdateMS;
+		NewInput->MouseX = OldInput->MouseX;
+		NewInput->MouseY = OldInput->MouseY;
+		NewInput->LastMouseX = OldInput->MouseX;
+		NewInput->LastMouseY = OldInput->MouseY;
+		for(uint32 ButtonIndex = 0;
+			ButtonIndex < ArrayCount(NewInput->Buttons);
+			++ButtonIndex)
+		{
+			NewInput->Buttons[ButtonIndex].EndedDown = OldInput->Buttons[ButtonIndex].EndedDown;
+		}
+
+		LinuxProcessPendingMessages(XDisplay, DeleteWindowAtom, NewInput, KeysDown,
+									&WindowWidth, &WindowHeight, &Offscreen);
+		if((WindowWidth != BufferWidth) || (WindowHeight != BufferHeight))
+		{
+			LinuxResizeScreenBuffer(XDisplay, VisualInfo.visual, VisualInfo.depth, &Offscreen, &ScreenBuffer,
+									WindowWidth, WindowHeight);
+			BufferWidth = WindowWidth;
+			BufferHeight = WindowHeight;
+		}
+		if(!ScreenBuffer.BitmapMemory)
+		{
+			break;
+		}
+
+		uint64 UpdateStartTime = LinuxGetWallClock();
+		MarkFrameStage(&GlobalFrameTiming, FrameStage_UpdateAndRender, UpdateStartTime);
+		EditorUpdateAndRender(&AppState, &ScreenBuffer, NewInput);
+		LastUpdateMS = LinuxGetSecondsElapsed(UpdateStartTime, LinuxGetWallClock()) * 1000.0f;
+
+		MarkFrameStage(&GlobalFrameTiming, FrameStage_Present, LinuxGetWallClock());
+		LinuxDisplayBufferInWindow(XDisplay, XWindow, Context, &Offscreen, &ScreenBuffer);
+		uint64 PresentTime = LinuxGetWallClock();
+		MarkFramePresented(&GlobalFrameTiming, PresentTime);
+		MarkFrameStage(&GlobalFrameTiming, FrameStage_Wait, PresentTime);
+
+		struct app_input *TempInput = NewInput;
+		NewInput = OldInput;
+		OldInput = TempInput;
+
+		real32 MSElapsedForFrame = LinuxGetSecondsElapsed(StartTime, LinuxGetWallClock()) * 1000.0f;
+		if(MSElapsedForFrame < TargetMSPerFrame)
+		{
+			real32 MSToSleep = (real32)(TargetMSPerFrame - MSElapsedForFrame);
+			struct timespec SleepTime = {0};
+			SleepTime.tv_nsec = (long)(MSToSleep * 1000000.0f);
+			nanosleep(&SleepTime, 0);
+		}
+
+		uint64 FrameEndTime = LinuxGetWallClock();
+		EndFrameTiming(&GlobalFrameTiming, FrameEndTime);
+		LastFrameMS = LinuxGetSecondsElapsed(StartTime, FrameEndTime) * 1000.0f;
+		if(GlobalWriteTimingTrace)
+		{
+			char Summary[256] = {0};
+			FormatTimingSummary(&GlobalFrameTiming, Summary, sizeof(Summary));
+			fputs(Summary, stderr);
+			WriteFrameTimingTrace(&GlobalFrameTiming, "FrameTiming.json",
+								  LinuxAllocateMemory, LinuxWriteFile, LinuxFreeMemory);
+			GlobalWriteTimingTrace = false;
+		}
+
+		++FramesRun;
+		if(FrameLimit && (FramesRun >= FrameLimit))
+		{
+			GlobalRunning = false;
+		}
+	}
+
+	if(FrameLimit)
+	{
+		char Summary[256] = {0};
+		FormatTimingSummary(&GlobalFrameTiming, Summary, sizeof(Summary));
+		fputs(Summary, stderr);
+	}
+	else
+	{
+		WriteFrameTimingTrace(&GlobalFrameTiming, "FrameTiming.json",
+							  LinuxAllocateMemory, LinuxWriteFile, LinuxFreeMemory);
+		WriteSessionSnapshot(&AppState, SESSION_FILENAME);
+	}
+
+	LinuxFreeOffscreenBuffer(XDisplay, &Offscreen);
+	XFreeGC(XDisplay, Context);
+	XDestroyWindow(XDisplay, XWindow);
+	XCloseDisplay(XDisplay);
+	return 0;
+}
@@ -0,0 +1,41 @@
+#ifndef LINUX_PIXEL_EDITOR_H
+
+// NOTE(rick): The screen buffer is backed by a MIT-SHM segment when the X
+// server supports it, so presenting is the server copying straight out of our
+// memory. The segment is allocated with some slack and only replaced when the
+// window outgrows it. RowHashes remembers what each presented row held so
+// only the rows that changed are sent.
+struct linux_offscreen_buffer
+{
+	XImage *Image;
+	XShmSegmentInfo SegmentInfo;
+	bool32 UsingSharedMemory;
+	void *Memory;
+	uint32 CapacityBytes;
+
+	uint64 *RowHashes;
+	uint32 RowHashCapacity;
+	bool32 NeedsFullPresent;
+};
+
+#define LINUX_SCREEN_BUFFER_GRANULARITY 256
+#define LINUX_MAX_WORKER_THREADS 15
+
+// NOTE(rick): Same scheme as the win32 work queue. One batch of jobs at a
+// time, handed out by bumping NextJob; the calling thread helps and then waits
+// for every worker it woke to check back in.
+struct linux_work_queue
+{
+	sem_t Semaphore;
+	uint32 WorkerCount;
+
+	platform_work_callback *Callback;
+	void *Context;
+	int32 JobCount;
+	volatile int32 NextJob;
+	volatile int32 CompletedJobs;
+	volatile int32 WorkersCheckedIn;
+};
+
+#define LINUX_PIXEL_EDITOR_H
+#endif
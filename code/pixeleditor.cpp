@@ -1,4 +1,5 @@
 #include "pixeleditor.h"
+#include "pixeleditor_blit.cpp"
 
 static inline union v4
 U32ToV4Pixel(uint32 Color)
@@ -103,7 +104,7 @@ DrawRectangleWithBounds(struct game_screen_buffer *Buffer,
 		{
 			if((Y == MaxY-1) || (X == MaxX-1))
 			{
-				*Pixel++ = 0xff666666;
+				*Pixel++ = GRID_LINE_COLOR;
 			}
 			else
 			{
@@ -114,15 +115,48 @@ DrawRectangleWithBounds(struct game_screen_buffer *Buffer,
 	}
 }
 
+static inline void
+ScreenToPixelMapGrid(struct app_state *AppState, real32 X, real32 Y, int32 *GridX, int32 *GridY)
+{
+	int32 MouseX = (int32)X;
+	int32 MouseY = (int32)Y;
+	*GridX = (int32)floorf(((MouseX - AppState->EditingAreaOffset.x) / AppState->PixelMapZoom) - AppState->EditingAreaMapOffset.x);
+	*GridY = (int32)floorf(((MouseY - AppState->EditingAreaOffset.y) / AppState->PixelMapZoom) - AppState->EditingAreaMapOffset.y);
+}
+
+static inline union v2
+PixelMapGridToScreen(struct app_state *AppState, real32 GridX, real32 GridY)
+{
+	union v2 Result = {0};
+	Result.x = AppState->EditingAreaOffset.x + ((GridX + AppState->EditingAreaMapOffset.x) * AppState->PixelMapZoom);
+	Result.y = AppState->EditingAreaOffset.y + ((GridY + AppState->EditingAreaMapOffset.y) * AppState->PixelMapZoom);
+	return(Result);
+}
+
+static inline int32
+WrapCoordinate(int32 Value, int32 Size)
+{
+	int32 Result = Value % Size;
+	if(Result < 0)
+	{
+		Result += Size;
+	}
+	return(Result);
+}
+
 static inline union v4 *
 GetPixelMapPixelColor(struct app_state *AppState, real32 X, real32 Y)
 {
 	union v4 *Result = 0;
 
-	int32 MouseX = (int32)X;
-	int32 MouseY = (int32)Y;
-	int32 GridX = ((MouseX - AppState->EditingAreaOffset.x) / AppState->PixelMapZoom) - AppState->EditingAreaMapOffset.x;
-	int32 GridY = ((MouseY - AppState->EditingAreaOffset.y) / AppState->PixelMapZoom) - AppState->EditingAreaMapOffset.y;
+	int32 GridX = 0;
+	int32 GridY = 0;
+	ScreenToPixelMapGrid(AppState, X, Y, &GridX, &GridY);
+	if(AppState->Wrap.Enabled)
+	{
+		GridX = WrapCoordinate(GridX, AppState->PixelMapWidth);
+		GridY = WrapCoordinate(GridY, AppState->PixelMapHeight);
+	}
 
 	if(((GridX >= 0) && (GridX < AppState->PixelMapWidth)) &&
 	   ((GridY >= 0) && (GridY < AppState->PixelMapHeight)))
@@ -161,7 +195,36 @@ ActionPerformedWithinRegion(bool32 InputState, real32 MouseX, real32 MouseY,
 	return(Result);
 }
 
+inline static bool32
+ButtonWasPressed(struct input_button_state *Button)
+{
+	bool32 Result = (Button->EndedDown && (Button->HalfTransitionCount > 0));
+	return(Result);
+}
+
+// NOTE(rick): Platforms without worker threads leave PlatformRunParallel
+// unset, the jobs then just run one after another on this thread.
 static void
+RunParallel(struct app_state *AppState, platform_work_callback *Callback, void *Context, uint32 JobCount)
+{
+	if(AppState->PlatformRunParallel && (JobCount > 1))
+	{
+		AppState->PlatformRunParallel(Callback, Context, JobCount);
+	}
+	else
+	{
+		for(uint32 JobIndex = 0; JobIndex < JobCount; ++JobIndex)
+		{
+			Callback(Context, JobIndex);
+		}
+	}
+}
+
+#include "pixeleditor_selection.cpp"
+#include "pixeleditor_shapes.cpp"
+#include "pixeleditor_gradient.cpp"
+
+static bool32
 ExportBitmap(char *Filename, v4 *PixelMap, uint32 Width, uint32 Height, struct app_state *AppState)
 {
 	struct bitmap_header BitmapHeader = {0};
@@ -174,9 +237,20 @@ ExportBitmap(char *Filename, v4 *PixelMap, uint32 Width, uint32 Height, struct a
 	BitmapHeader.InfoHeader.BitsPerPixel = 32;
 	BitmapHeader.InfoHeader.Compression = BI_RGB;
 
-	uint32 BitmapDataSize = sizeof(struct bitmap_header) + ((Width * Height) * (BitmapHeader.InfoHeader.BitsPerPixel / 8));
+	// NOTE(rick): Bitmap sizes are 32-bit and so is PlatformAllocateMemory.
+	uint64 FileSize = sizeof(struct bitmap_header) + ((uint64)Width * Height * (BitmapHeader.InfoHeader.BitsPerPixel / 8));
+	if(FileSize > 0xFFFFFFFF)
+	{
+		return(false);
+	}
+
+	uint32 BitmapDataSize = (uint32)FileSize;
+	BitmapHeader.FileSize = BitmapDataSize;
 	uint8 *BitmapData = (uint8 *)AppState->PlatformAllocateMemory(BitmapDataSize);
-	Assert(BitmapData != 0);
+	if(!BitmapData)
+	{
+		return(false);
+	}
 
 	*((struct bitmap_header *)BitmapData) = BitmapHeader;
 	uint32 *Dest = (uint32 *)(BitmapData + sizeof(struct bitmap_header));
@@ -192,8 +266,9 @@ ExportBitmap(char *Filename, v4 *PixelMap, uint32 Width, uint32 Height, struct a
 		}
 	}
 
-	AppState->PlatformWriteFile(Filename, BitmapData, sizeof(struct bitmap_header) + BitmapDataSize);
+	bool32 Result = AppState->PlatformWriteFile(Filename, BitmapData, BitmapDataSize);
 	AppState->PlatformFreeMemory(BitmapData);
+	return(Result);
 }
 
 static void
@@ -208,6 +283,17 @@ UpdatePixelEditorPosition(struct app_state *AppState, struct app_input *Input)
 		AppState->EditingAreaMapOffset.y += (Input->MouseY - Input->LastMouseY) / AppState->PixelMapZoom;
 	}
 
+	// NOTE(rick): Panning is unbounded in wrap mode, the offset is only kept
+	// within one canvas so it doesn't lose precision.
+	if(AppState->Wrap.Enabled)
+	{
+		AppState->EditingAreaMapOffset.x = fmodf(AppState->EditingAreaMapOffset.x, (real32)AppState->PixelMapWidth);
+		AppState->EditingAreaMapOffset.y = fmodf(AppState->EditingAreaMapOffset.y, (real32)AppState->PixelMapHeight);
+		if(AppState->EditingAreaMapOffset.x > 0) { AppState->EditingAreaMapOffset.x -= AppState->PixelMapWidth; }
+		if(AppState->EditingAreaMapOffset.y > 0) { AppState->EditingAreaMapOffset.y -= AppState->PixelMapHeight; }
+		return;
+	}
+
 	if(AppState->EditingAreaMapOffset.x > 0)
 	{
 		AppState->EditingAreaMapOffset.x = 0;
@@ -227,39 +313,87 @@ UpdatePixelEditorPosition(struct app_state *AppState, struct app_input *Input)
 	}
 }
 
+// NOTE(rick): The fit-to-window zoom ResizeCanvas starts at, or in wrap mode
+// the whole zoom that fits WRAP_PREVIEW_REPEATS copies across if that is
+// further out.
 static void
-ResizeCanvas(struct app_state *AppState, int32 CanvasWidth, int32 CanvasHeight)
+UpdateMinPixelMapZoom(struct app_state *AppState)
 {
-	if(AppState->PixelMap)
+	real32 MinZoom = AppState->EditingAreaSize.x / (real32)AppState->PixelMapWidth;
+	if(MinZoom < 5.0f)
 	{
-		AppState->PlatformFreeMemory(AppState->PixelMap);
+		MinZoom = 5.0f;
 	}
 
+	if(AppState->Wrap.Enabled)
+	{
+		real32 WrapZoom = floorf(AppState->EditingAreaSize.x / (real32)(WRAP_PREVIEW_REPEATS * AppState->PixelMapWidth));
+		if(WrapZoom < WRAP_MIN_ZOOM)
+		{
+			WrapZoom = WRAP_MIN_ZOOM;
+		}
+		if(WrapZoom < MinZoom)
+		{
+			MinZoom = WrapZoom;
+		}
+	}
+
+	AppState->MinPixelMapZoom = MinZoom;
+}
+
+#include "pixeleditor_animation.cpp"
+#include "pixeleditor_save.cpp"
+#include "pixeleditor_transform.cpp"
+#include "pixeleditor_reference.cpp"
+#include "pixeleditor_text.cpp"
+#include "pixeleditor_colorpicker.cpp"
+#include "pixeleditor_undo.cpp"
+#include "pixeleditor_recolor.cpp"
+#include "pixeleditor_export.cpp"
+#include "pixeleditor_scaler.cpp"
+#include "pixeleditor_wrap.cpp"
+
+// NOTE(rick): Existing content is kept anchored to the top-left corner, it is
+// cropped when the canvas shrinks and padded with blank cells when it grows.
+static void
+ResizeCanvas(struct app_state *AppState, int32 CanvasWidth, int32 CanvasHeight)
+{
+	ClearSelection(AppState);
+	SyncCurrentFrame(AppState);
+	struct pixel_buffer OldCanvas = PixelMapBuffer(AppState);
+
 	AppState->EditingAreaSize = V2(700.0f, 700.0f);
 	AppState->EditingAreaOffset = V2(80.0f, 10.0f);
 	AppState->PixelMapWidth = CanvasWidth;
 	AppState->PixelMapHeight = CanvasHeight;
-	AppState->PixelMapZoom = AppState->EditingAreaSize.x / (real32)AppState->PixelMapWidth;
-	AppState->MinPixelMapZoom = AppState->PixelMapZoom;
-	if(AppState->PixelMapZoom < 5.0f)
-	{
-		AppState->PixelMapZoom = 5.0f;
-		AppState->MinPixelMapZoom = 5.0f;
-	}
+	UpdateMinPixelMapZoom(AppState);
+	AppState->PixelMapZoom = AppState->MinPixelMapZoom;
 
 	uint32 PixelMapSize = AppState->PixelMapWidth * AppState->PixelMapHeight;
 	AppState->PixelMap = (v4 *)AppState->PlatformAllocateMemory(PixelMapSize * sizeof(v4));
 	Assert(AppState->PixelMap);
 
+	if(OldCanvas.Pixels)
+	{
+		struct pixel_buffer NewCanvas = PixelMapBuffer(AppState);
+		BlitPixelBuffer(&NewCanvas, 0, 0, &OldCanvas, 0, 0, OldCanvas.Width, OldCanvas.Height,
+						BlitMode_Copy, V4(0.0f, 0.0f, 0.0f, 0.0f), 0);
+		AppState->PlatformFreeMemory(OldCanvas.Pixels);
+	}
+	RetileAnimationFrames(AppState);
+
 	UpdatePixelEditorPosition(AppState, NULL);
 }
 
+#include "pixeleditor_session.cpp"
+
 static void
 EditorUpdateAndRender(struct app_state *AppState, struct game_screen_buffer *Buffer, struct app_input *Input)
 {
 	if(!AppState->Initialized)
 	{
 		ResizeCanvas(AppState, 64, 64);
+		InitializeAnimation(AppState);
 		AppState->ColorPickerButton.Position = V2(AppState->EditingAreaOffset.x, AppState->EditingAreaOffset.y + AppState->EditingAreaSize.y + 10);
 		AppState->ColorPickerButton.Dimensions = V2(64, 64);
 		AppState->ColorPickerButton.Color = V4(0xff, 0x00, 0x00, 0xff);
@@ -269,6 +403,8 @@ EditorUpdateAndRender(struct app_state *AppState, struct game_screen_buffer *Buf
 		AppState->QuickSwitchColor.Color = V4(0xff, 0xff, 0xff, 0xff);
 
 		AppState->PixelColor = AppState->ColorPickerButton.Color;
+		AppState->Gradient.Dither = GradientDither_Bayer;
+		AppState->Gradient.Steps = MIN_GRADIENT_STEPS;
 		AppState->CustomColorDims = V2(30.0f, 30.0f);
 
 		int32 ButtonsPerRow = 8;
@@ -291,6 +427,17 @@ EditorUpdateAndRender(struct app_state *AppState, struct game_screen_buffer *Buf
 
 		}
 
+		AppState->AnimationTimelinePosition = V2(AppState->CustomColorButtons[ButtonsPerRow - 1].Position.x + AppState->CustomColorDims.x + 14,
+												 AppState->ColorPickerButton.Position.y);
+		AppState->StatusPosition = V2(10.0f,
+									  AppState->ColorPickerButton.Position.y + AppState->ColorPickerButton.Dimensions.y + 8);
+		InitializeTextRenderer(AppState);
+		InitializeColorPicker(AppState);
+		if(!AppState->SessionDisabled)
+		{
+			RestoreSessionSnapshot(AppState, SESSION_FILENAME);
+		}
+
 		AppState->Initialized = true;
 	}
 
@@ -337,24 +484,252 @@ EditorUpdateAndRender(struct app_state *AppState, struct game_screen_buffer *Buf
 		}
 	}
 
+	if(Input->ButtonToolPencil.Tapped)
+	{
+		CommitFloatingSelection(AppState);
+		AppState->Tool = EditorTool_Pencil;
+	}
+	if(Input->ButtonToolRectangleSelect.Tapped)
+	{
+		AppState->Tool = EditorTool_RectangleSelect;
+	}
+	if(Input->ButtonToolLassoSelect.Tapped)
+	{
+		AppState->Tool = EditorTool_LassoSelect;
+	}
+	if(Input->ButtonToolMove.Tapped)
+	{
+		AppState->Tool = EditorTool_Move;
+	}
+	if(Input->ButtonToolLine.Tapped)
+	{
+		CommitFloatingSelection(AppState);
+		AppState->Tool = EditorTool_Line;
+	}
+	if(Input->ButtonToolRectangle.Tapped)
+	{
+		CommitFloatingSelection(AppState);
+		AppState->Tool = EditorTool_Rectangle;
+	}
+	if(Input->ButtonToolEllipse.Tapped)
+	{
+		CommitFloatingSelection(AppState);
+		AppState->Tool = EditorTool_Ellipse;
+	}
+	if(Input->ButtonToggleShapeFill.Tapped)
+	{
+		AppState->Shape.Filled = !AppState->Shape.Filled;
+	}
+	if(Input->ButtonToolGradient.Tapped)
+	{
+		if(AppState->Tool == EditorTool_Gradient)
+		{
+			AppState->Gradient.Kind = ((AppState->Gradient.Kind == GradientKind_Linear) ?
+									   GradientKind_Radial : GradientKind_Linear);
+		}
+		else
+		{
+			CommitFloatingSelection(AppState);
+			AppState->Tool = EditorTool_Gradient;
+		}
+	}
+	if(Input->ButtonToggleGradientDither.Tapped)
+	{
+		AppState->Gradient.Dither = ((AppState->Gradient.Dither == GradientDither_None) ?
+									 GradientDither_Bayer : GradientDither_None);
+	}
+	if(Input->ButtonCycleGradientSteps.Tapped)
+	{
+		++AppState->Gradient.Steps;
+		if(AppState->Gradient.Steps > MAX_GRADIENT_STEPS)
+		{
+			AppState->Gradient.Steps = MIN_GRADIENT_STEPS;
+		}
+	}
+	if(Input->ButtonRotateClockwise.Tapped)
+	{
+		TransformCanvasOrSelection(AppState, PixelTransform_Rotate90);
+	}
+	if(Input->ButtonRotateCounterClockwise.Tapped)
+	{
+		TransformCanvasOrSelection(AppState, PixelTransform_Rotate270);
+	}
+	if(Input->ButtonRotateHalf.Tapped)
+	{
+		TransformCanvasOrSelection(AppState, PixelTransform_Rotate180);
+	}
+	if(Input->ButtonFlipHorizontal.Tapped)
+	{
+		TransformCanvasOrSelection(AppState, PixelTransform_FlipHorizontal);
+	}
+	if(Input->ButtonFlipVertical.Tapped)
+	{
+		TransformCanvasOrSelection(AppState, PixelTransform_FlipVertical);
+	}
+	if(Input->ButtonScaleUp.Tapped)
+	{
+		ScaleCanvasOrSelection(AppState, 2, true);
+	}
+	if(Input->ButtonScaleDown.Tapped)
+	{
+		ScaleCanvasOrSelection(AppState, 2, false);
+	}
+	if(Input->ButtonAddFrame.Tapped)
+	{
+		AddAnimationFrame(AppState);
+	}
+	if(Input->ButtonDeleteFrame.Tapped)
+	{
+		DeleteAnimationFrame(AppState);
+	}
+	if(Input->ButtonPreviousFrame.Tapped)
+	{
+		SelectAnimationFrame(AppState, AppState->Animation.CurrentFrame - 1);
+	}
+	if(Input->ButtonNextFrame.Tapped)
+	{
+		SelectAnimationFrame(AppState, AppState->Animation.CurrentFrame + 1);
+	}
+	if(Input->ButtonPlayAnimation.Tapped)
+	{
+		AppState->Animation.Playing = !AppState->Animation.Playing;
+	}
+	if(Input->ButtonOnionSkin.Tapped)
+	{
+		AppState->Animation.OnionSkinEnabled = !AppState->Animation.OnionSkinEnabled;
+	}
+	if(Input->ButtonIncreaseFPS.Tapped)
+	{
+		AppState->Animation.FramesPerSecond += 1.0f;
+		if(AppState->Animation.FramesPerSecond > 60.0f)
+		{
+			AppState->Animation.FramesPerSecond = 60.0f;
+		}
+	}
+	if(Input->ButtonDecreaseFPS.Tapped)
+	{
+		AppState->Animation.FramesPerSecond -= 1.0f;
+		if(AppState->Animation.FramesPerSecond < 1.0f)
+		{
+			AppState->Animation.FramesPerSecond = 1.0f;
+		}
+	}
+	if(Input->ButtonReplaceColor.Tapped)
+	{
+		ReplaceColorUnderCursor(AppState, Input);
+	}
+	if(Input->ButtonSwapPalette.Tapped)
+	{
+		SwapPaletteFromCustomColors(AppState);
+	}
+	if(Input->ButtonCycleTolerance.Tapped)
+	{
+		AppState->RecolorTolerance = (AppState->RecolorTolerance == 0.0f) ? 4.0f : (AppState->RecolorTolerance * 2.0f);
+		if(AppState->RecolorTolerance > 64.0f)
+		{
+			AppState->RecolorTolerance = 0.0f;
+		}
+	}
+	if(Input->ButtonUndo.Tapped)
+	{
+		UndoLastEdit(AppState);
+	}
+	if(Input->ButtonExportSpriteSheet.Tapped)
+	{
+		ExportSpriteSheet("SpriteSheet.bmp", AppState);
+	}
+	if(Input->ButtonExportScaled.Tapped)
+	{
+		ExportStandardScales(AppState);
+	}
+
+	if(Input->ButtonLoadReference.Tapped)
+	{
+		LoadReferenceImage(AppState, "Reference.bmp");
+	}
+	if(Input->ButtonCycleReferenceMode.Tapped)
+	{
+		CycleReferenceMode(AppState);
+	}
+	if(Input->ButtonReferenceOpacityUp.Tapped)
+	{
+		AdjustReferenceOpacity(AppState, REFERENCE_OPACITY_STEP);
+	}
+	if(Input->ButtonReferenceOpacityDown.Tapped)
+	{
+		AdjustReferenceOpacity(AppState, -REFERENCE_OPACITY_STEP);
+	}
+	if(Input->ButtonReferenceScaleUp.Tapped)
+	{
+		ScaleReference(AppState, REFERENCE_SCALE_STEP);
+	}
+	if(Input->ButtonReferenceScaleDown.Tapped)
+	{
+		ScaleReference(AppState, 1.0f / REFERENCE_SCALE_STEP);
+	}
+	if(Input->ButtonReferenceLeft.Tapped)
+	{
+		NudgeReference(AppState, -1.0f, 0.0f);
+	}
+	if(Input->ButtonReferenceRight.Tapped)
+	{
+		NudgeReference(AppState, 1.0f, 0.0f);
+	}
+	if(Input->ButtonReferenceUp.Tapped)
+	{
+		NudgeReference(AppState, 0.0f, -1.0f);
+	}
+	if(Input->ButtonReferenceDown.Tapped)
+	{
+		NudgeReference(AppState, 0.0f, 1.0f);
+	}
+	if(Input->ButtonToggleWrap.Tapped)
+	{
+		ToggleWrapMode(AppState);
+	}
+	UpdateAnimationPlayback(AppState, Input->dtForFrame);
+
+	if(Input->ButtonCopy.Tapped)
+	{
+		CopySelection(AppState);
+	}
+	if(Input->ButtonCut.Tapped)
+	{
+		CutSelection(AppState);
+	}
+	if(Input->ButtonPaste.Tapped)
+	{
+		PasteSelection(AppState);
+	}
+	if(Input->ButtonDelete.Tapped)
+	{
+		DeleteSelection(AppState);
+	}
+	if(Input->ButtonDeselect.Tapped)
+	{
+		ClearSelection(AppState);
+	}
+
 	if(Input->ButtonSave.Tapped)
 	{
-		ExportBitmap("Bitmap.bmp", AppState->PixelMap, AppState->PixelMapWidth, AppState->PixelMapHeight, AppState);
+		CommitFloatingSelection(AppState);
+		SaveCanvas("Bitmap.bmp", AppState);
 	}
 	if(Input->ButtonReset.Tapped)
 	{
+		DiscardSelection(AppState);
 		v4 *PixelData = AppState->PixelMap;
 		for(int32 Y = 0; Y < AppState->PixelMapHeight; ++Y)
 		{
 			for(int32 X = 0; X < AppState->PixelMapWidth; ++X)
 			{
-				*PixelData++ = V4(0.0f, 0.0f, 0.0f, 0xff);
+				*PixelData++ = V4(0.0f, 0.0f, 0.0f, 0.0f);
 			}
 		}
 	}
 	if(Input->ButtonEraser.Tapped)
 	{
-		AppState->PixelColor = V4(0.0f, 0.0f, 0.0f, 0xff);
+		AppState->PixelColor = V4(0.0f, 0.0f, 0.0f, 0.0f);
 	}
 	if(Input->ButtonQuickSwitch.Tapped)
 	{
@@ -367,49 +742,67 @@ EditorUpdateAndRender(struct app_state *AppState, struct game_screen_buffer *Buf
 		AppState->EyeDropperModeEnabled = !AppState->EyeDropperModeEnabled;
 	}
 
-	AppState->ColorPickerButtonClicked = ActionPerformedWithinRegion(Input->ButtonPrimary.EndedDown,
-																	 Input->MouseX, Input->MouseY,
-																	 AppState->ColorPickerButton.Position.x,
-																	 AppState->ColorPickerButton.Position.y,
-																	 AppState->ColorPickerButton.Dimensions.x,
-																	 AppState->ColorPickerButton.Dimensions.y);
-
-	if(ActionPerformedWithinRegion(Input->ButtonSecondary.EndedDown, Input->MouseX, Input->MouseY,
-								   AppState->EditingAreaOffset.x, AppState->EditingAreaOffset.y,
-								   AppState->EditingAreaSize.x, AppState->EditingAreaSize.y))
-	{
-		UpdatePixelEditorPosition(AppState, Input);
-	}
-	else if(ActionPerformedWithinRegion(Input->ButtonPrimary.EndedDown, Input->MouseX, Input->MouseY,
-										AppState->EditingAreaOffset.x, AppState->EditingAreaOffset.y,
-										AppState->EditingAreaSize.x, AppState->EditingAreaSize.y))
+	bool32 ColorPickerHasMouse = UpdateColorPicker(AppState, Input);
+	if(!ColorPickerHasMouse)
 	{
-		if(AppState->EyeDropperModeEnabled)
+		if(AppState->Tool != EditorTool_Pencil)
 		{
-			// TODO(rick): Add some sort of visual queue that we're in eye
-			// dropper mode
-			v4 *Pixel = GetPixelMapPixelColor(AppState, Input->MouseX, Input->MouseY);
-			if(Pixel != NULL)
+			bool32 PressedInEditingArea = ActionPerformedWithinRegion(ButtonWasPressed(&Input->ButtonPrimary),
+																	  Input->MouseX, Input->MouseY,
+																	  AppState->EditingAreaOffset.x, AppState->EditingAreaOffset.y,
+																	  AppState->EditingAreaSize.x, AppState->EditingAreaSize.y);
+			if(IsShapeTool(AppState->Tool))
 			{
-				AppState->PixelColor = *Pixel;
+				UpdateShapeTool(AppState, Input, PressedInEditingArea);
+			}
+			else if(AppState->Tool == EditorTool_Gradient)
+			{
+				UpdateGradientTool(AppState, Input, PressedInEditingArea);
+			}
+			else
+			{
+				UpdateSelectionTool(AppState, Input, PressedInEditingArea);
 			}
 		}
-		else
+
+		if(ActionPerformedWithinRegion(Input->ButtonSecondary.EndedDown, Input->MouseX, Input->MouseY,
+									   AppState->EditingAreaOffset.x, AppState->EditingAreaOffset.y,
+									   AppState->EditingAreaSize.x, AppState->EditingAreaSize.y))
 		{
-			SetPixelMapPixelColor(AppState, Input->MouseX, Input->MouseY, AppState->PixelColor);
+			UpdatePixelEditorPosition(AppState, Input);
+		}
+		else if((AppState->Tool == EditorTool_Pencil) &&
+				ActionPerformedWithinRegion(Input->ButtonPrimary.EndedDown, Input->MouseX, Input->MouseY,
+											AppState->EditingAreaOffset.x, AppState->EditingAreaOffset.y,
+											AppState->EditingAreaSize.x, AppState->EditingAreaSize.y))
+		{
+			if(AppState->EyeDropperModeEnabled)
+			{
+				// TODO(rick): Add some sort of visual queue that we're in eye
+				// dropper mode
+				v4 *Pixel = GetPixelMapPixelColor(AppState, Input->MouseX, Input->MouseY);
+				if(Pixel != NULL)
+				{
+					AppState->PixelColor = *Pixel;
+				}
+			}
+			else
+			{
+				SetPixelMapPixelColor(AppState, Input->MouseX, Input->MouseY, AppState->PixelColor);
+			}
 		}
-	}
 
-	for(int32 CustomColorIndex = 0;
-		CustomColorIndex < ArrayCount(AppState->CustomColorButtons);
-		++CustomColorIndex)
-	{
-		struct custom_color_button Button = *(AppState->CustomColorButtons + CustomColorIndex);
-		if(ActionPerformedWithinRegion(Input->ButtonPrimary.EndedDown, Input->MouseX, Input->MouseY,
-									   Button.Position.x, Button.Position.y,
-									   Button.Dimensions.x, Button.Dimensions.y))
+		for(int32 CustomColorIndex = 0;
+			CustomColorIndex < ArrayCount(AppState->CustomColorButtons);
+			++CustomColorIndex)
 		{
-			AppState->PixelColor = Button.Color;
+			struct custom_color_button Button = *(AppState->CustomColorButtons + CustomColorIndex);
+			if(ActionPerformedWithinRegion(Input->ButtonPrimary.EndedDown, Input->MouseX, Input->MouseY,
+										   Button.Position.x, Button.Position.y,
+										   Button.Dimensions.x, Button.Dimensions.y))
+			{
+				AppState->PixelColor = Button.Color;
+			}
 		}
 	}
 
@@ -421,24 +814,20 @@ EditorUpdateAndRender(struct app_state *AppState, struct game_screen_buffer *Buf
 				  AppState->EditingAreaSize.x, AppState->EditingAreaSize.y,
 				  V4(0.0f, 0.0f, 0.0f, 255.0f));
 
-	for(uint32 MapY = 0;
-		MapY < AppState->PixelMapHeight;
-		++MapY)
+	if(AppState->Wrap.Enabled)
 	{
-		for(uint32 MapX = 0;
-			MapX < AppState->PixelMapWidth;
-			++MapX)
-		{
-			v4 *Pixel = AppState->PixelMap + (MapY * AppState->PixelMapWidth) + MapX;
-			DrawRectangleWithBounds(Buffer,
-									AppState->EditingAreaOffset.x, AppState->EditingAreaOffset.x + AppState->EditingAreaSize.x,
-									AppState->EditingAreaOffset.y, AppState->EditingAreaOffset.y + AppState->EditingAreaSize.y,
-									AppState->EditingAreaOffset.x + ((MapX + AppState->EditingAreaMapOffset.x) * AppState->PixelMapZoom),
-									AppState->EditingAreaOffset.y + ((MapY + AppState->EditingAreaMapOffset.y) * AppState->PixelMapZoom),
-									AppState->PixelMapZoom, AppState->PixelMapZoom, *Pixel);
-		}
+		DrawWrappedPixelMap(Buffer, AppState);
+	}
+	else
+	{
+		DrawPixelMap(Buffer, AppState);
 	}
 
+	DrawReference(Buffer, AppState);
+	DrawSelection(Buffer, AppState, Input);
+	DrawShapePreview(Buffer, AppState);
+	DrawGradientGuide(Buffer, AppState);
+
 	DrawRectangle(Buffer, AppState->QuickSwitchColor.Position.x, AppState->QuickSwitchColor.Position.y,
 				  AppState->QuickSwitchColor.Dimensions.x, AppState->QuickSwitchColor.Dimensions.y,
 				  AppState->QuickSwitchColor.Color);
@@ -455,4 +844,8 @@ EditorUpdateAndRender(struct app_state *AppState, struct game_screen_buffer *Buf
 					  Button.Dimensions.y, Button.Color);
 	}
 
+	UpdateAndDrawAnimationTimeline(Buffer, AppState, Input);
+	DrawStatusOverlay(Buffer, AppState, Input);
+	DrawColorPicker(Buffer, AppState);
+
 }
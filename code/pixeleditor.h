@@ -2,13 +2,18 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <emmintrin.h>
 
 typedef uint8_t uint8;
 typedef uint16_t uint16;
 typedef uint32_t uint32;
+typedef uint64_t uint64;
 typedef int8_t int8;
 typedef int16_t int16;
 typedef int32_t int32;
+typedef int64_t int64;
 typedef float real32;
 typedef double real64;
 typedef int32 bool32;
@@ -77,6 +82,11 @@ struct app_input
 	real32 LastMouseX;
 	real32 LastMouseY;
 	int32 MouseWheelScrollDirection;
+
+	// NOTE(rick): Measured by the platform layer for the previous frame, for
+	// display only.
+	real32 LastFrameMS;
+	real32 LastUpdateMS;
 	union
 	{
 		struct input_button_state Buttons[3];
@@ -97,6 +107,59 @@ struct app_input
 			struct input_button_state ButtonSize4;  // 256
 			struct input_button_state ButtonSize5;  // 512
 			struct input_button_state ButtonSize6;  // 1024
+
+			struct input_button_state ButtonToolPencil;
+			struct input_button_state ButtonToolRectangleSelect;
+			struct input_button_state ButtonToolLassoSelect;
+			struct input_button_state ButtonToolMove;
+			struct input_button_state ButtonToolLine;
+			struct input_button_state ButtonToolRectangle;
+			struct input_button_state ButtonToolEllipse;
+			struct input_button_state ButtonToggleShapeFill;
+			struct input_button_state ButtonToolGradient;
+			struct input_button_state ButtonToggleGradientDither;
+			struct input_button_state ButtonCycleGradientSteps;
+			struct input_button_state ButtonReplaceColor;
+			struct input_button_state ButtonSwapPalette;
+			struct input_button_state ButtonCycleTolerance;
+			struct input_button_state ButtonUndo;
+			struct input_button_state ButtonCopy;
+			struct input_button_state ButtonCut;
+			struct input_button_state ButtonPaste;
+			struct input_button_state ButtonDelete;
+			struct input_button_state ButtonDeselect;
+
+			struct input_button_state ButtonRotateClockwise;
+			struct input_button_state ButtonRotateCounterClockwise;
+			struct input_button_state ButtonRotateHalf;
+			struct input_button_state ButtonFlipHorizontal;
+			struct input_button_state ButtonFlipVertical;
+			struct input_button_state ButtonScaleUp;
+			struct input_button_state ButtonScaleDown;
+
+			struct input_button_state ButtonAddFrame;
+			struct input_button_state ButtonDeleteFrame;
+			struct input_button_state ButtonPreviousFrame;
+			struct input_button_state ButtonNextFrame;
+			struct input_button_state ButtonPlayAnimation;
+			struct input_button_state ButtonOnionSkin;
+			struct input_button_state ButtonIncreaseFPS;
+			struct input_button_state ButtonDecreaseFPS;
+			struct input_button_state ButtonExportSpriteSheet;
+			struct input_button_state ButtonExportScaled;
+
+			struct input_button_state ButtonLoadReference;
+			struct input_button_state ButtonCycleReferenceMode;
+			struct input_button_state ButtonReferenceOpacityUp;
+			struct input_button_state ButtonReferenceOpacityDown;
+			struct input_button_state ButtonReferenceScaleUp;
+			struct input_button_state ButtonReferenceScaleDown;
+			struct input_button_state ButtonReferenceLeft;
+			struct input_button_state ButtonReferenceRight;
+			struct input_button_state ButtonReferenceUp;
+			struct input_button_state ButtonReferenceDown;
+
+			struct input_button_state ButtonToggleWrap;
 		};
 	};
 };
@@ -154,18 +217,104 @@ struct custom_color_button
 	v4 Color;
 };
 
+#define MAX_CUSTOM_COLORS 16
+
+#include "pixeleditor_blit.h"
+#include "pixeleditor_selection.h"
+#include "pixeleditor_transform.h"
+#include "pixeleditor_animation.h"
+#include "pixeleditor_shapes.h"
+#include "pixeleditor_gradient.h"
+#include "pixeleditor_save.h"
+#include "pixeleditor_text.h"
+#include "pixeleditor_colorpicker.h"
+#include "pixeleditor_undo.h"
+#include "pixeleditor_recolor.h"
+#include "pixeleditor_export.h"
+#include "pixeleditor_reference.h"
+#include "pixeleditor_session.h"
+#include "pixeleditor_scaler.h"
+#include "pixeleditor_wrap.h"
+
+enum editor_tool
+{
+	EditorTool_Pencil,
+	EditorTool_RectangleSelect,
+	EditorTool_LassoSelect,
+	EditorTool_Move,
+	EditorTool_Line,
+	EditorTool_Rectangle,
+	EditorTool_Ellipse,
+	EditorTool_Gradient,
+};
+
 #define PLATFORM_WRITE_FILE(name) bool32 name(char *Filename, void *Data, uint32 Size)
 typedef PLATFORM_WRITE_FILE(platform_write_file);
 
+struct platform_file_range
+{
+	uint64 Offset;
+	void *Data;
+	uint32 Size;
+};
+
+// NOTE(rick): Overwrites ranges of an existing file in place. Fails without
+// writing anything if the file is missing or is not ExpectedFileSize bytes.
+#define PLATFORM_WRITE_FILE_RANGES(name) bool32 name(char *Filename, uint64 ExpectedFileSize, struct platform_file_range *Ranges, uint32 RangeCount)
+typedef PLATFORM_WRITE_FILE_RANGES(platform_write_file_ranges);
+
+struct platform_file_contents
+{
+	void *Data;
+	uint32 Size;
+};
+
+// NOTE(rick): Data is 0 if the file couldn't be read. It is released with
+// PlatformFreeMemory.
+#define PLATFORM_READ_ENTIRE_FILE(name) struct platform_file_contents name(char *Filename)
+typedef PLATFORM_READ_ENTIRE_FILE(platform_read_entire_file);
+
+// NOTE(rick): Maps a file read-only into memory. Data is 0 if that fails and
+// is released with PlatformUnmapFile.
+#define PLATFORM_MAP_FILE(name) struct platform_file_contents name(char *Filename)
+typedef PLATFORM_MAP_FILE(platform_map_file);
+
+#define PLATFORM_UNMAP_FILE(name) void name(void *Memory, uint32 Size)
+typedef PLATFORM_UNMAP_FILE(platform_unmap_file);
+
+// NOTE(rick): Writes a file out in pieces, for output too large to build in
+// memory first. Begin returns 0 if the file can't be created; End closes it
+// and reports whether everything appended made it to disk.
+#define PLATFORM_BEGIN_WRITE_FILE(name) void *name(char *Filename)
+typedef PLATFORM_BEGIN_WRITE_FILE(platform_begin_write_file);
+
+#define PLATFORM_APPEND_TO_FILE(name) bool32 name(void *File, void *Data, uint32 Size)
+typedef PLATFORM_APPEND_TO_FILE(platform_append_to_file);
+
+#define PLATFORM_END_WRITE_FILE(name) bool32 name(void *File)
+typedef PLATFORM_END_WRITE_FILE(platform_end_write_file);
+
 #define PLATFORM_ALLOCATE_MEMORY(name) void * name(uint32 Size)
 typedef PLATFORM_ALLOCATE_MEMORY(platform_allocate_memory);
 
 #define PLATFORM_FREE_MEMORY(name) void name(void *Memory)
 typedef PLATFORM_FREE_MEMORY(platform_free_memory);
 
+#define PLATFORM_WORK_CALLBACK(name) void name(void *Context, uint32 JobIndex)
+typedef PLATFORM_WORK_CALLBACK(platform_work_callback);
+
+// NOTE(rick): Calls Callback once for every JobIndex in [0, JobCount), spread
+// over the platform's worker threads, and only returns once all of them have
+// finished. Jobs must not depend on each other.
+#define PLATFORM_RUN_PARALLEL(name) void name(platform_work_callback *Callback, void *Context, uint32 JobCount)
+typedef PLATFORM_RUN_PARALLEL(platform_run_parallel);
+
 struct app_state
 {
 	bool32 Initialized;
+	// NOTE(rick): Set by the platform layer for runs that must neither pick up
+	// nor leave behind a session file, like headless test runs.
+	bool32 SessionDisabled;
 	bool32 EyeDropperModeEnabled;
 
 	uint32 PixelMapWidth;
@@ -180,15 +329,39 @@ struct app_state
 
 	struct custom_color_button QuickSwitchColor;
 	struct custom_color_button ColorPickerButton;
-	bool32 ColorPickerButtonClicked;
+	struct color_picker_state ColorPicker;
 	v4 PixelColor;
 
-	struct custom_color_button CustomColorButtons[16];
+	struct custom_color_button CustomColorButtons[MAX_CUSTOM_COLORS];
 	v2 CustomColorDims;
 
+	enum editor_tool Tool;
+	struct selection_state Selection;
+	struct shape_state Shape;
+	struct gradient_state Gradient;
+	struct save_state Save;
+	struct undo_state Undo;
+	struct reference_state Reference;
+	struct wrap_state Wrap;
+	real32 RecolorTolerance;
+
+	struct animation_state Animation;
+	v2 AnimationTimelinePosition;
+
+	struct text_state Text;
+	v2 StatusPosition;
+
+	platform_read_entire_file *PlatformReadEntireFile;
+	platform_map_file *PlatformMapFile;
+	platform_unmap_file *PlatformUnmapFile;
 	platform_write_file *PlatformWriteFile;
+	platform_write_file_ranges *PlatformWriteFileRanges;
+	platform_begin_write_file *PlatformBeginWriteFile;
+	platform_append_to_file *PlatformAppendToFile;
+	platform_end_write_file *PlatformEndWriteFile;
 	platform_allocate_memory *PlatformAllocateMemory;
 	platform_free_memory *PlatformFreeMemory;
+	platform_run_parallel *PlatformRunParallel;
 };
 
 #define PIXEL_EDITOR_H
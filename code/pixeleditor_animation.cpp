@@ -0,0 +1,582 @@
+static uint64
+HashTilePixels(v4 *Pixels)
+{
+	uint64 *Words = (uint64 *)Pixels;
+	uint64 Hash = 0x9e3779b97f4a7c15;
+	for(uint32 WordIndex = 0;
+		WordIndex < ((TILE_PIXEL_COUNT * sizeof(v4)) / sizeof(uint64));
+		++WordIndex)
+	{
+		Hash ^= Words[WordIndex];
+		Hash *= 0xff51afd7ed558ccd;
+		Hash ^= (Hash >> 32);
+	}
+	return(Hash);
+}
+
+static inline struct tile_entry *
+GetTileEntry(struct tile_store *Store, uint32 TileIndex)
+{
+	Assert(TileIndex < Store->TileCount);
+	struct tile_entry *Result = Store->Chunks[TileIndex / TILES_PER_CHUNK]->Entries + (TileIndex % TILES_PER_CHUNK);
+	return(Result);
+}
+
+static inline v4 *
+GetTilePixels(struct tile_store *Store, uint32 TileIndex)
+{
+	Assert(TileIndex < Store->TileCount);
+	v4 *Result = Store->Chunks[TileIndex / TILES_PER_CHUNK]->Pixels[TileIndex % TILES_PER_CHUNK];
+	return(Result);
+}
+
+// NOTE(rick): Finds the index of a tile holding exactly these pixels, adding
+// one to the store if none exists yet. The caller owns one reference. Fails
+// only if the store has to grow and the memory for that can't be had.
+static bool32
+InternTile(struct app_state *AppState, struct tile_store *Store, v4 *Pixels, uint32 *Result)
+{
+	uint64 Hash = HashTilePixels(Pixels);
+	uint32 *Bucket = Store->Buckets + (Hash % TILE_HASH_BUCKET_COUNT);
+	for(uint32 Link = *Bucket; Link != 0; )
+	{
+		struct tile_entry *Entry = GetTileEntry(Store, Link - 1);
+		if((Entry->Hash == Hash) &&
+		   (memcmp(GetTilePixels(Store, Link - 1), Pixels, TILE_PIXEL_COUNT * sizeof(v4)) == 0))
+		{
+			++Entry->RefCount;
+			*Result = Link - 1;
+			return(true);
+		}
+		Link = Entry->NextInBucket;
+	}
+
+	uint32 TileIndex = 0;
+	if(Store->FirstFreeTile)
+	{
+		TileIndex = Store->FirstFreeTile - 1;
+		Store->FirstFreeTile = GetTileEntry(Store, TileIndex)->NextInBucket;
+	}
+	else
+	{
+		if(Store->TileCount == (Store->ChunkCount * TILES_PER_CHUNK))
+		{
+			if(Store->ChunkCount == Store->ChunkCapacity)
+			{
+				uint32 ChunkCapacity = Store->ChunkCapacity ? (Store->ChunkCapacity * 2) : INITIAL_TILE_CHUNK_CAPACITY;
+				struct tile_chunk **Chunks = (struct tile_chunk **)AppState->PlatformAllocateMemory(ChunkCapacity * sizeof(struct tile_chunk *));
+				if(!Chunks)
+				{
+					return(false);
+				}
+				if(Store->Chunks)
+				{
+					memcpy(Chunks, Store->Chunks, Store->ChunkCount * sizeof(struct tile_chunk *));
+					AppState->PlatformFreeMemory(Store->Chunks);
+				}
+				Store->Chunks = Chunks;
+				Store->ChunkCapacity = ChunkCapacity;
+			}
+
+			struct tile_chunk *Chunk = (struct tile_chunk *)AppState->PlatformAllocateMemory(sizeof(struct tile_chunk));
+			if(!Chunk)
+			{
+				return(false);
+			}
+			Store->Chunks[Store->ChunkCount++] = Chunk;
+		}
+		TileIndex = Store->TileCount++;
+	}
+
+	struct tile_entry *Entry = GetTileEntry(Store, TileIndex);
+	Entry->Hash = Hash;
+	Entry->RefCount = 1;
+	Entry->NextInBucket = *Bucket;
+	*Bucket = TileIndex + 1;
+	memcpy(GetTilePixels(Store, TileIndex), Pixels, TILE_PIXEL_COUNT * sizeof(v4));
+	++Store->UniqueTileCount;
+
+	*Result = TileIndex;
+	return(true);
+}
+
+static void
+ReleaseTile(struct tile_store *Store, uint32 TileIndex)
+{
+	struct tile_entry *Entry = GetTileEntry(Store, TileIndex);
+	Assert(Entry->RefCount > 0);
+	if(--Entry->RefCount == 0)
+	{
+		uint32 *Link = Store->Buckets + (Entry->Hash % TILE_HASH_BUCKET_COUNT);
+		while(*Link != (TileIndex + 1))
+		{
+			Link = &GetTileEntry(Store, *Link - 1)->NextInBucket;
+		}
+		*Link = Entry->NextInBucket;
+
+		Entry->NextInBucket = Store->FirstFreeTile;
+		Store->FirstFreeTile = TileIndex + 1;
+		--Store->UniqueTileCount;
+	}
+}
+
+static inline void
+AddTileReference(struct tile_store *Store, uint32 TileIndex)
+{
+	++GetTileEntry(Store, TileIndex)->RefCount;
+}
+
+// NOTE(rick): Copies one tile's worth of Source into Tile. Cells past the edge
+// of Source are zeroed so edge tiles hash the same way every time.
+static void
+GatherTile(v4 *Tile, struct pixel_buffer *Source, int32 TileX, int32 TileY)
+{
+	memset(Tile, 0, TILE_PIXEL_COUNT * sizeof(v4));
+	struct pixel_buffer TileBuffer = PixelBuffer(Tile, TILE_SIZE, TILE_SIZE);
+	BlitPixelBuffer(&TileBuffer, 0, 0, Source, TileX * TILE_SIZE, TileY * TILE_SIZE,
+					TILE_SIZE, TILE_SIZE, BlitMode_Copy, V4(0.0f, 0.0f, 0.0f, 0.0f), 0);
+}
+
+static bool32
+TileMatchesBuffer(v4 *Tile, struct pixel_buffer *Source, int32 TileX, int32 TileY)
+{
+	int32 MinX = TileX * TILE_SIZE;
+	int32 MinY = TileY * TILE_SIZE;
+	int32 Width = Source->Width - MinX;
+	int32 Height = Source->Height - MinY;
+	if(Width > TILE_SIZE) { Width = TILE_SIZE; }
+	if(Height > TILE_SIZE) { Height = TILE_SIZE; }
+
+	for(int32 Y = 0; Y < Height; ++Y)
+	{
+		if(memcmp(Tile + (Y * TILE_SIZE), PixelBufferRow(Source, MinY + Y) + MinX, Width * sizeof(v4)) != 0)
+		{
+			return(false);
+		}
+	}
+	return(true);
+}
+
+// NOTE(rick): Returns 0 if there isn't the memory for the grid or its blank
+// tile.
+static uint32 *
+AllocateFrameTiles(struct app_state *AppState, int32 TilesX, int32 TilesY)
+{
+	struct tile_store *Store = &AppState->Animation.Tiles;
+	uint32 *Result = (uint32 *)AppState->PlatformAllocateMemory(TilesX * TilesY * sizeof(uint32));
+	if(!Result)
+	{
+		return(0);
+	}
+
+	v4 BlankTile[TILE_PIXEL_COUNT] = {0};
+	uint32 BlankTileIndex = 0;
+	if(!InternTile(AppState, Store, BlankTile, &BlankTileIndex))
+	{
+		AppState->PlatformFreeMemory(Result);
+		return(0);
+	}
+	for(int32 TileIndex = 0; TileIndex < (TilesX * TilesY); ++TileIndex)
+	{
+		Result[TileIndex] = BlankTileIndex;
+		AddTileReference(Store, BlankTileIndex);
+	}
+	ReleaseTile(Store, BlankTileIndex);
+
+	return(Result);
+}
+
+static void
+FreeFrameTiles(struct app_state *AppState, uint32 *FrameTiles, int32 TileCount)
+{
+	for(int32 TileIndex = 0; TileIndex < TileCount; ++TileIndex)
+	{
+		ReleaseTile(&AppState->Animation.Tiles, FrameTiles[TileIndex]);
+	}
+	AppState->PlatformFreeMemory(FrameTiles);
+}
+
+// NOTE(rick): Only tiles whose pixels differ from what the frame already
+// references are hashed and interned, so storing a lightly edited frame costs
+// about a compare of the canvas. If the tile store can't grow this stops
+// early; the tiles stored so far are kept and the rest still hold their old
+// contents.
+static bool32
+StoreFrameTiles(struct app_state *AppState, uint32 *FrameTiles, int32 TilesX, int32 TilesY,
+				struct pixel_buffer *Source)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	for(int32 TileY = 0; TileY < TilesY; ++TileY)
+	{
+		for(int32 TileX = 0; TileX < TilesX; ++TileX)
+		{
+			uint32 *TileIndex = FrameTiles + (TileY * TilesX) + TileX;
+			if(!TileMatchesBuffer(GetTilePixels(&Animation->Tiles, *TileIndex), Source, TileX, TileY))
+			{
+				v4 Tile[TILE_PIXEL_COUNT];
+				GatherTile(Tile, Source, TileX, TileY);
+				uint32 NewTileIndex = 0;
+				if(!InternTile(AppState, &Animation->Tiles, Tile, &NewTileIndex))
+				{
+					return(false);
+				}
+				ReleaseTile(&Animation->Tiles, *TileIndex);
+				*TileIndex = NewTileIndex;
+			}
+		}
+	}
+	return(true);
+}
+
+static bool32
+StoreFrame(struct app_state *AppState, int32 FrameIndex, struct pixel_buffer *Source)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	bool32 Result = StoreFrameTiles(AppState, Animation->FrameTiles[FrameIndex], Animation->TilesX, Animation->TilesY, Source);
+	return(Result);
+}
+
+static void
+LoadFrame(struct app_state *AppState, int32 FrameIndex, struct pixel_buffer *Dest, int32 DestX, int32 DestY)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	uint32 *FrameTiles = Animation->FrameTiles[FrameIndex];
+	for(int32 TileY = 0; TileY < Animation->TilesY; ++TileY)
+	{
+		int32 Height = AppState->PixelMapHeight - (TileY * TILE_SIZE);
+		if(Height > TILE_SIZE) { Height = TILE_SIZE; }
+		for(int32 TileX = 0; TileX < Animation->TilesX; ++TileX)
+		{
+			int32 Width = AppState->PixelMapWidth - (TileX * TILE_SIZE);
+			if(Width > TILE_SIZE) { Width = TILE_SIZE; }
+
+			uint32 TileIndex = FrameTiles[(TileY * Animation->TilesX) + TileX];
+			struct pixel_buffer Tile = PixelBuffer(GetTilePixels(&Animation->Tiles, TileIndex), TILE_SIZE, TILE_SIZE);
+			BlitPixelBuffer(Dest, DestX + (TileX * TILE_SIZE), DestY + (TileY * TILE_SIZE), &Tile, 0, 0,
+							Width, Height, BlitMode_Copy, V4(0.0f, 0.0f, 0.0f, 0.0f), 0);
+		}
+	}
+}
+
+static inline v4 *
+GetFramePixel(struct app_state *AppState, int32 FrameIndex, int32 X, int32 Y)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	uint32 TileIndex = Animation->FrameTiles[FrameIndex][((Y / TILE_SIZE) * Animation->TilesX) + (X / TILE_SIZE)];
+	v4 *Result = GetTilePixels(&Animation->Tiles, TileIndex) + ((Y % TILE_SIZE) * TILE_SIZE) + (X % TILE_SIZE);
+	return(Result);
+}
+
+static void
+InitializeAnimation(struct app_state *AppState)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	Animation->TilesX = (AppState->PixelMapWidth + TILE_SIZE - 1) / TILE_SIZE;
+	Animation->TilesY = (AppState->PixelMapHeight + TILE_SIZE - 1) / TILE_SIZE;
+	Animation->FrameCount = 1;
+	Animation->CurrentFrame = 0;
+	Animation->FrameTiles[0] = AllocateFrameTiles(AppState, Animation->TilesX, Animation->TilesY);
+	Assert(Animation->FrameTiles[0]);
+	Animation->FramesPerSecond = 12.0f;
+	Animation->OnionSkinOpacity = 0.35f;
+	Animation->Initialized = true;
+
+	struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+	StoreFrame(AppState, 0, &Canvas);
+}
+
+// NOTE(rick): The canvas stays the authority for the current frame, so a
+// failed sync loses nothing; anything that is about to replace the canvas or
+// read every frame back has to check for it though.
+static bool32
+SyncCurrentFrame(struct app_state *AppState)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	bool32 Result = true;
+	if(Animation->Initialized)
+	{
+		struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+		Result = StoreFrame(AppState, Animation->CurrentFrame, &Canvas);
+	}
+	return(Result);
+}
+
+// NOTE(rick): Every frame shares the canvas dimensions. When those change the
+// stored frames are cropped or padded from the top-left corner to match, the
+// same way ResizeCanvas treats the canvas itself.
+static void
+RetileAnimationFrames(struct app_state *AppState)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	if(!Animation->Initialized)
+	{
+		return;
+	}
+
+	int32 OldTilesX = Animation->TilesX;
+	int32 OldTilesY = Animation->TilesY;
+	int32 TilesX = (AppState->PixelMapWidth + TILE_SIZE - 1) / TILE_SIZE;
+	int32 TilesY = (AppState->PixelMapHeight + TILE_SIZE - 1) / TILE_SIZE;
+	for(int32 FrameIndex = 0; FrameIndex < Animation->FrameCount; ++FrameIndex)
+	{
+		uint32 *OldFrameTiles = Animation->FrameTiles[FrameIndex];
+		uint32 *FrameTiles = AllocateFrameTiles(AppState, TilesX, TilesY);
+		// NOTE(rick): Same as the canvas allocation in ResizeCanvas.
+		Assert(FrameTiles);
+		for(int32 TileY = 0; (TileY < TilesY) && (TileY < OldTilesY); ++TileY)
+		{
+			int32 Height = AppState->PixelMapHeight - (TileY * TILE_SIZE);
+			if(Height > TILE_SIZE) { Height = TILE_SIZE; }
+			for(int32 TileX = 0; (TileX < TilesX) && (TileX < OldTilesX); ++TileX)
+			{
+				int32 Width = AppState->PixelMapWidth - (TileX * TILE_SIZE);
+				if(Width > TILE_SIZE) { Width = TILE_SIZE; }
+
+				v4 Tile[TILE_PIXEL_COUNT] = {0};
+				struct pixel_buffer OldTile = PixelBuffer(GetTilePixels(&Animation->Tiles, OldFrameTiles[(TileY * OldTilesX) + TileX]), TILE_SIZE, TILE_SIZE);
+				struct pixel_buffer NewTile = PixelBuffer(Tile, TILE_SIZE, TILE_SIZE);
+				BlitPixelBuffer(&NewTile, 0, 0, &OldTile, 0, 0, Width, Height, BlitMode_Copy, V4(0.0f, 0.0f, 0.0f, 0.0f), 0);
+
+				// NOTE(rick): A tile that can't be stored is left blank rather
+				// than failing the resize half way through.
+				uint32 *TileIndex = FrameTiles + (TileY * TilesX) + TileX;
+				uint32 NewTileIndex = 0;
+				if(InternTile(AppState, &Animation->Tiles, Tile, &NewTileIndex))
+				{
+					ReleaseTile(&Animation->Tiles, *TileIndex);
+					*TileIndex = NewTileIndex;
+				}
+			}
+		}
+
+		FreeFrameTiles(AppState, OldFrameTiles, OldTilesX * OldTilesY);
+		Animation->FrameTiles[FrameIndex] = FrameTiles;
+	}
+
+	Animation->TilesX = TilesX;
+	Animation->TilesY = TilesY;
+}
+
+static void
+SelectAnimationFrame(struct app_state *AppState, int32 FrameIndex)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	if((FrameIndex == Animation->CurrentFrame) ||
+	   (FrameIndex < 0) || (FrameIndex >= Animation->FrameCount))
+	{
+		return;
+	}
+
+	CommitFloatingSelection(AppState);
+	if(!SyncCurrentFrame(AppState))
+	{
+		return;
+	}
+
+	struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+	LoadFrame(AppState, FrameIndex, &Canvas, 0, 0);
+	Animation->CurrentFrame = FrameIndex;
+}
+
+// NOTE(rick): New frames start as a copy of the current one and share all of
+// its tiles until they are edited.
+static void
+AddAnimationFrame(struct app_state *AppState)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	if(Animation->FrameCount >= MAX_ANIMATION_FRAMES)
+	{
+		return;
+	}
+
+	CommitFloatingSelection(AppState);
+	if(!SyncCurrentFrame(AppState))
+	{
+		return;
+	}
+
+	int32 TileCount = Animation->TilesX * Animation->TilesY;
+	uint32 *FrameTiles = (uint32 *)AppState->PlatformAllocateMemory(TileCount * sizeof(uint32));
+	if(!FrameTiles)
+	{
+		return;
+	}
+	uint32 *SourceTiles = Animation->FrameTiles[Animation->CurrentFrame];
+	for(int32 TileIndex = 0; TileIndex < TileCount; ++TileIndex)
+	{
+		FrameTiles[TileIndex] = SourceTiles[TileIndex];
+		AddTileReference(&Animation->Tiles, FrameTiles[TileIndex]);
+	}
+
+	int32 NewFrame = Animation->CurrentFrame + 1;
+	for(int32 FrameIndex = Animation->FrameCount; FrameIndex > NewFrame; --FrameIndex)
+	{
+		Animation->FrameTiles[FrameIndex] = Animation->FrameTiles[FrameIndex - 1];
+	}
+	Animation->FrameTiles[NewFrame] = FrameTiles;
+	++Animation->FrameCount;
+	Animation->CurrentFrame = NewFrame;
+}
+
+static void
+DeleteAnimationFrame(struct app_state *AppState)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	if(Animation->FrameCount <= 1)
+	{
+		return;
+	}
+
+	DiscardSelection(AppState);
+	FreeFrameTiles(AppState, Animation->FrameTiles[Animation->CurrentFrame], Animation->TilesX * Animation->TilesY);
+	for(int32 FrameIndex = Animation->CurrentFrame; FrameIndex < (Animation->FrameCount - 1); ++FrameIndex)
+	{
+		Animation->FrameTiles[FrameIndex] = Animation->FrameTiles[FrameIndex + 1];
+	}
+	--Animation->FrameCount;
+	if(Animation->CurrentFrame >= Animation->FrameCount)
+	{
+		Animation->CurrentFrame = Animation->FrameCount - 1;
+	}
+
+	struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+	LoadFrame(AppState, Animation->CurrentFrame, &Canvas, 0, 0);
+}
+
+static void
+UpdateAnimationPlayback(struct app_state *AppState, real32 dtForFrame)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	if(!Animation->Playing || (Animation->FrameCount <= 1))
+	{
+		Animation->PlaybackTime = 0.0f;
+		return;
+	}
+
+	real32 SecondsPerFrame = 1.0f / Animation->FramesPerSecond;
+	Animation->PlaybackTime += dtForFrame;
+	int32 FramesToAdvance = 0;
+	while(Animation->PlaybackTime >= SecondsPerFrame)
+	{
+		Animation->PlaybackTime -= SecondsPerFrame;
+		++FramesToAdvance;
+	}
+
+	if(FramesToAdvance)
+	{
+		SelectAnimationFrame(AppState, (Animation->CurrentFrame + FramesToAdvance) % Animation->FrameCount);
+	}
+}
+
+static void
+ExportSpriteSheet(char *Filename, struct app_state *AppState)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	CommitFloatingSelection(AppState);
+	if(!SyncCurrentFrame(AppState))
+	{
+		return;
+	}
+
+	int32 Columns = (int32)ceilf(sqrtf((real32)Animation->FrameCount));
+	int32 Rows = (Animation->FrameCount + Columns - 1) / Columns;
+
+	// NOTE(rick): The sheet is built in memory and written as one bitmap, so
+	// both have to fit the 32-bit sizes PlatformAllocateMemory and the bitmap
+	// header use.
+	uint64 SheetWidth = (uint64)Columns * AppState->PixelMapWidth;
+	uint64 SheetHeight = (uint64)Rows * AppState->PixelMapHeight;
+	uint64 FileSize = sizeof(struct bitmap_header) + (SheetWidth * SheetHeight * sizeof(uint32));
+	uint64 SheetSize = SheetWidth * SheetHeight * sizeof(v4);
+	if((FileSize > 0xFFFFFFFF) || (SheetSize > 0xFFFFFFFF))
+	{
+		return;
+	}
+
+	struct pixel_buffer Sheet = {0};
+	if(AllocatePixelBuffer(AppState, &Sheet, (int32)SheetWidth, (int32)SheetHeight))
+	{
+		for(int32 FrameIndex = 0; FrameIndex < Animation->FrameCount; ++FrameIndex)
+		{
+			LoadFrame(AppState, FrameIndex, &Sheet,
+					  (FrameIndex % Columns) * AppState->PixelMapWidth,
+					  (FrameIndex / Columns) * AppState->PixelMapHeight);
+		}
+
+		ExportBitmap(Filename, Sheet.Pixels, Sheet.Width, Sheet.Height, AppState);
+		FreePixelBuffer(AppState, &Sheet);
+	}
+}
+
+static inline v4
+BlendOnionSkin(v4 Color, v4 Neighbour, v4 Tint, real32 Opacity)
+{
+	v4 Result = Color;
+	for(int32 Channel = 0; Channel < 3; ++Channel)
+	{
+		real32 Tinted = 0.5f * (Neighbour.E[Channel] + Tint.E[Channel]);
+		Result.E[Channel] = Color.E[Channel] + (Opacity * (Tinted - Color.E[Channel]));
+	}
+	Result.a = 0xff;
+	return(Result);
+}
+
+// NOTE(rick): Cells where the previous frame differs are washed towards red
+// and cells where the next frame differs towards blue. A washed cell is drawn
+// opaque even if it is empty so a reference underlay doesn't hide it.
+static v4
+ApplyOnionSkin(struct app_state *AppState, int32 X, int32 Y, v4 Color)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	v4 Result = Color;
+
+	int32 PreviousFrame = Animation->CurrentFrame - 1;
+	if(PreviousFrame >= 0)
+	{
+		v4 *Neighbour = GetFramePixel(AppState, PreviousFrame, X, Y);
+		if(memcmp(Neighbour, &Color, sizeof(v4)) != 0)
+		{
+			Result = BlendOnionSkin(Result, *Neighbour, V4(0xff, 0x00, 0x00, 0xff), Animation->OnionSkinOpacity);
+		}
+	}
+
+	int32 NextFrame = Animation->CurrentFrame + 1;
+	if(NextFrame < Animation->FrameCount)
+	{
+		v4 *Neighbour = GetFramePixel(AppState, NextFrame, X, Y);
+		if(memcmp(Neighbour, &Color, sizeof(v4)) != 0)
+		{
+			Result = BlendOnionSkin(Result, *Neighbour, V4(0x00, 0x00, 0xff, 0xff), Animation->OnionSkinOpacity);
+		}
+	}
+
+	return(Result);
+}
+
+static void
+UpdateAndDrawAnimationTimeline(struct game_screen_buffer *Buffer, struct app_state *AppState, struct app_input *Input)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	int32 FramesPerRow = 32;
+	real32 BoxSize = 8.0f;
+	real32 BoxSpacing = 10.0f;
+	v2 Origin = AppState->AnimationTimelinePosition;
+
+	for(int32 FrameIndex = 0; FrameIndex < Animation->FrameCount; ++FrameIndex)
+	{
+		real32 X = Origin.x + ((FrameIndex % FramesPerRow) * BoxSpacing);
+		real32 Y = Origin.y + ((FrameIndex / FramesPerRow) * BoxSpacing);
+		if(ActionPerformedWithinRegion(ButtonWasPressed(&Input->ButtonPrimary), Input->MouseX, Input->MouseY,
+									   X, Y, BoxSize, BoxSize))
+		{
+			SelectAnimationFrame(AppState, FrameIndex);
+		}
+
+		v4 Color = V4(0x55, 0x55, 0x55, 0xff);
+		if(FrameIndex == Animation->CurrentFrame)
+		{
+			Color = Animation->Playing ? V4(0x44, 0xcc, 0x44, 0xff) : V4(0xdd, 0xdd, 0xdd, 0xff);
+		}
+		DrawRectangle(Buffer, X, Y, BoxSize, BoxSize, Color);
+	}
+}
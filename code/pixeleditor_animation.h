@@ -0,0 +1,67 @@
+#ifndef PIXEL_EDITOR_ANIMATION_H
+
+// NOTE(rick): Frames are stored as grids of indices into a shared pool of
+// TILE_SIZE x TILE_SIZE tiles. Tiles are looked up by content hash when a
+// frame is stored, so identical tiles across frames share one copy. Stored
+// tiles are never written to; an edited tile is stored as a new tile and the
+// old one released, which gives copy-on-write for free.
+//
+// NOTE(rick): Bucket heads, bucket chains and the free list hold a tile index
+// plus one so that zeroed memory reads as an empty table.
+//
+// NOTE(rick): The chunk table doubles whenever it fills, so the pool is only
+// bounded by memory. Running out of that makes InternTile fail, and whatever
+// was storing the tile backs out.
+#define TILE_SIZE 16
+#define TILE_PIXEL_COUNT (TILE_SIZE * TILE_SIZE)
+#define TILES_PER_CHUNK 64
+#define INITIAL_TILE_CHUNK_CAPACITY 64
+#define TILE_HASH_BUCKET_COUNT 4096
+
+#define MAX_ANIMATION_FRAMES 256
+
+struct tile_entry
+{
+	uint64 Hash;
+	uint32 RefCount;
+	uint32 NextInBucket;
+};
+
+struct tile_chunk
+{
+	struct tile_entry Entries[TILES_PER_CHUNK];
+	v4 Pixels[TILES_PER_CHUNK][TILE_PIXEL_COUNT];
+};
+
+struct tile_store
+{
+	uint32 TileCount;
+	uint32 UniqueTileCount;
+	uint32 FirstFreeTile;
+	uint32 ChunkCount;
+	uint32 ChunkCapacity;
+	struct tile_chunk **Chunks;
+	uint32 Buckets[TILE_HASH_BUCKET_COUNT];
+};
+
+struct animation_state
+{
+	bool32 Initialized;
+	int32 FrameCount;
+	int32 CurrentFrame;
+	int32 TilesX;
+	int32 TilesY;
+	uint32 *FrameTiles[MAX_ANIMATION_FRAMES];
+
+	bool32 Playing;
+	real32 FramesPerSecond;
+	real32 PlaybackTime;
+
+	bool32 OnionSkinEnabled;
+	real32 OnionSkinOpacity;
+
+	struct tile_store Tiles;
+};
+
+#define PIXEL_EDITOR_ANIMATION_H
+#endif
@@ -0,0 +1,396 @@
+static inline struct pixel_buffer
+PixelBuffer(v4 *Pixels, int32 Width, int32 Height)
+{
+	struct pixel_buffer Result = {0};
+	Result.Width = Width;
+	Result.Height = Height;
+	Result.Pitch = Width;
+	Result.Pixels = Pixels;
+	return(Result);
+}
+
+static inline v4 *
+PixelBufferRow(struct pixel_buffer *Buffer, int32 Y)
+{
+	v4 *Result = Buffer->Pixels + (Y * Buffer->Pitch);
+	return(Result);
+}
+
+static bool32
+AllocatePixelBuffer(struct app_state *AppState, struct pixel_buffer *Buffer, int32 Width, int32 Height)
+{
+	if(Buffer->Pixels)
+	{
+		AppState->PlatformFreeMemory(Buffer->Pixels);
+	}
+
+	*Buffer = PixelBuffer(0, Width, Height);
+	// NOTE(rick): PlatformAllocateMemory takes a 32-bit size; anything larger
+	// is refused rather than wrapped.
+	uint64 Size = (uint64)Width * Height * sizeof(v4);
+	if((Width > 0) && (Height > 0) && (Size <= 0xFFFFFFFF))
+	{
+		Buffer->Pixels = (v4 *)AppState->PlatformAllocateMemory((uint32)Size);
+	}
+
+	bool32 Result = (Buffer->Pixels != 0);
+	return(Result);
+}
+
+static void
+FreePixelBuffer(struct app_state *AppState, struct pixel_buffer *Buffer)
+{
+	if(Buffer->Pixels)
+	{
+		AppState->PlatformFreeMemory(Buffer->Pixels);
+	}
+	*Buffer = PixelBuffer(0, 0, 0);
+}
+
+static bool32
+AllocatePixelMask(struct app_state *AppState, struct pixel_mask *Mask, int32 Width, int32 Height)
+{
+	if(Mask->Bits)
+	{
+		AppState->PlatformFreeMemory(Mask->Bits);
+	}
+
+	struct pixel_mask Empty = {0};
+	*Mask = Empty;
+	Mask->Width = Width;
+	Mask->Height = Height;
+	Mask->WordsPerRow = (Width + 31) / 32;
+	if((Width > 0) && (Height > 0))
+	{
+		// NOTE(rick): PlatformAllocateMemory hands back zeroed memory so the
+		// mask starts out empty.
+		Mask->Bits = (uint32 *)AppState->PlatformAllocateMemory(Mask->WordsPerRow * Height * sizeof(uint32));
+	}
+
+	bool32 Result = (Mask->Bits != 0);
+	return(Result);
+}
+
+static void
+FreePixelMask(struct app_state *AppState, struct pixel_mask *Mask)
+{
+	if(Mask->Bits)
+	{
+		AppState->PlatformFreeMemory(Mask->Bits);
+	}
+	struct pixel_mask Empty = {0};
+	*Mask = Empty;
+}
+
+static inline uint32 *
+PixelMaskRow(struct pixel_mask *Mask, int32 Y)
+{
+	uint32 *Result = Mask->Bits + (Y * Mask->WordsPerRow);
+	return(Result);
+}
+
+static inline bool32
+IsPixelMaskSet(struct pixel_mask *Mask, int32 X, int32 Y)
+{
+	bool32 Result = false;
+	if((X >= 0) && (X < Mask->Width) &&
+	   (Y >= 0) && (Y < Mask->Height))
+	{
+		uint32 *Row = PixelMaskRow(Mask, Y);
+		Result = ((Row[X >> 5] >> (X & 31)) & 1);
+	}
+	return(Result);
+}
+
+static void
+WritePixelMaskSpan(struct pixel_mask *Mask, int32 Y, int32 MinX, int32 MaxX, bool32 Set)
+{
+	if(MinX < 0) { MinX = 0; }
+	if(MaxX > Mask->Width) { MaxX = Mask->Width; }
+	if((Y < 0) || (Y >= Mask->Height) || (MaxX <= MinX))
+	{
+		return;
+	}
+
+	uint32 *Row = PixelMaskRow(Mask, Y);
+	int32 X = MinX;
+	while(X < MaxX)
+	{
+		if(((X & 31) == 0) && ((X + 32) <= MaxX))
+		{
+			Row[X >> 5] = (Set ? 0xffffffff : 0);
+			X += 32;
+		}
+		else
+		{
+			if(Set)
+			{
+				Row[X >> 5] |= (1 << (X & 31));
+			}
+			else
+			{
+				Row[X >> 5] &= ~(1 << (X & 31));
+			}
+			++X;
+		}
+	}
+}
+
+static bool32
+CopyPixelMask(struct app_state *AppState, struct pixel_mask *Dest, struct pixel_mask *Source)
+{
+	bool32 Result = AllocatePixelMask(AppState, Dest, Source->Width, Source->Height);
+	if(Result)
+	{
+		memcpy(Dest->Bits, Source->Bits, Source->WordsPerRow * Source->Height * sizeof(uint32));
+	}
+	return(Result);
+}
+
+// NOTE(rick): Returns the first bit in [Bit, EndBit) whose state is not Set,
+// or EndBit if the whole range matches. Whole words are stepped over at once.
+static int32
+FindPixelMaskRunEnd(uint32 *MaskRow, int32 Bit, int32 EndBit, bool32 Set)
+{
+	uint32 FullWord = (Set ? 0xffffffff : 0);
+	while(Bit < EndBit)
+	{
+		uint32 Word = MaskRow[Bit >> 5];
+		if(((Bit & 31) == 0) && (Word == FullWord))
+		{
+			Bit += 32;
+			continue;
+		}
+
+		if((bool32)((Word >> (Bit & 31)) & 1) != Set)
+		{
+			break;
+		}
+		++Bit;
+	}
+
+	if(Bit > EndBit)
+	{
+		Bit = EndBit;
+	}
+	return(Bit);
+}
+
+static void
+BlitRowCopy(v4 *Dest, v4 *Source, int32 Count, bool32 Reverse)
+{
+	if(!Reverse)
+	{
+		int32 X = 0;
+		for(; X + 4 <= Count; X += 4)
+		{
+			__m128 A = _mm_loadu_ps(Source[X + 0].E);
+			__m128 B = _mm_loadu_ps(Source[X + 1].E);
+			__m128 C = _mm_loadu_ps(Source[X + 2].E);
+			__m128 D = _mm_loadu_ps(Source[X + 3].E);
+			_mm_storeu_ps(Dest[X + 0].E, A);
+			_mm_storeu_ps(Dest[X + 1].E, B);
+			_mm_storeu_ps(Dest[X + 2].E, C);
+			_mm_storeu_ps(Dest[X + 3].E, D);
+		}
+		for(; X < Count; ++X)
+		{
+			_mm_storeu_ps(Dest[X].E, _mm_loadu_ps(Source[X].E));
+		}
+	}
+	else
+	{
+		int32 X = Count;
+		for(; X - 4 >= 0; X -= 4)
+		{
+			__m128 A = _mm_loadu_ps(Source[X - 1].E);
+			__m128 B = _mm_loadu_ps(Source[X - 2].E);
+			__m128 C = _mm_loadu_ps(Source[X - 3].E);
+			__m128 D = _mm_loadu_ps(Source[X - 4].E);
+			_mm_storeu_ps(Dest[X - 1].E, A);
+			_mm_storeu_ps(Dest[X - 2].E, B);
+			_mm_storeu_ps(Dest[X - 3].E, C);
+			_mm_storeu_ps(Dest[X - 4].E, D);
+		}
+		for(; X > 0; --X)
+		{
+			_mm_storeu_ps(Dest[X - 1].E, _mm_loadu_ps(Source[X - 1].E));
+		}
+	}
+}
+
+static inline __m128
+BlitSelectKeyed(__m128 Dest, __m128 Source, __m128 Key)
+{
+	// NOTE(rick): A pixel only matches the key when all four channels match,
+	// so fold the per-lane compare down into every lane before selecting.
+	__m128 Equal = _mm_cmpeq_ps(Source, Key);
+	Equal = _mm_and_ps(Equal, _mm_shuffle_ps(Equal, Equal, _MM_SHUFFLE(2, 3, 0, 1)));
+	Equal = _mm_and_ps(Equal, _mm_shuffle_ps(Equal, Equal, _MM_SHUFFLE(1, 0, 3, 2)));
+	__m128 Result = _mm_or_ps(_mm_and_ps(Equal, Dest), _mm_andnot_ps(Equal, Source));
+	return(Result);
+}
+
+static void
+BlitRowTransparentKey(v4 *Dest, v4 *Source, int32 Count, __m128 Key, bool32 Reverse)
+{
+	if(!Reverse)
+	{
+		for(int32 X = 0; X < Count; ++X)
+		{
+			__m128 Result = BlitSelectKeyed(_mm_loadu_ps(Dest[X].E), _mm_loadu_ps(Source[X].E), Key);
+			_mm_storeu_ps(Dest[X].E, Result);
+		}
+	}
+	else
+	{
+		for(int32 X = Count - 1; X >= 0; --X)
+		{
+			__m128 Result = BlitSelectKeyed(_mm_loadu_ps(Dest[X].E), _mm_loadu_ps(Source[X].E), Key);
+			_mm_storeu_ps(Dest[X].E, Result);
+		}
+	}
+}
+
+static void
+BlitRowMasked(v4 *Dest, v4 *Source, int32 Count, uint32 *MaskRow, int32 MaskX, bool32 Reverse)
+{
+	if(!Reverse)
+	{
+		// NOTE(rick): Walk the mask as alternating runs of clear and set bits
+		// and hand each set run to the row copier.
+		int32 EndBit = MaskX + Count;
+		int32 Bit = MaskX;
+		while(Bit < EndBit)
+		{
+			int32 RunStart = FindPixelMaskRunEnd(MaskRow, Bit, EndBit, false);
+			int32 RunEnd = FindPixelMaskRunEnd(MaskRow, RunStart, EndBit, true);
+			if(RunEnd > RunStart)
+			{
+				int32 Offset = RunStart - MaskX;
+				BlitRowCopy(Dest + Offset, Source + Offset, RunEnd - RunStart, false);
+			}
+			Bit = RunEnd;
+		}
+	}
+	else
+	{
+		// NOTE(rick): Only reached for right-shifting copies within a single
+		// row, which is rare enough that a plain per-pixel walk is fine.
+		for(int32 X = Count - 1; X >= 0; --X)
+		{
+			int32 Bit = MaskX + X;
+			if((MaskRow[Bit >> 5] >> (Bit & 31)) & 1)
+			{
+				_mm_storeu_ps(Dest[X].E, _mm_loadu_ps(Source[X].E));
+			}
+		}
+	}
+}
+
+// NOTE(rick): Copies a Width x Height block from Source at (SourceX, SourceY)
+// to Dest at (DestX, DestY), clipping against both buffers. When Mode is
+// BlitMode_Masked, Mask is indexed with the same coordinates as Source. Source
+// and Dest may be views over the same memory; rows and pixels are walked in
+// whichever direction keeps overlapping regions intact.
+static void
+BlitPixelBuffer(struct pixel_buffer *Dest, int32 DestX, int32 DestY,
+				struct pixel_buffer *Source, int32 SourceX, int32 SourceY,
+				int32 Width, int32 Height, enum blit_mode Mode,
+				union v4 Key, struct pixel_mask *Mask)
+{
+	if(SourceX < 0) { Width += SourceX; DestX -= SourceX; SourceX = 0; }
+	if(SourceY < 0) { Height += SourceY; DestY -= SourceY; SourceY = 0; }
+	if(DestX < 0) { Width += DestX; SourceX -= DestX; DestX = 0; }
+	if(DestY < 0) { Height += DestY; SourceY -= DestY; DestY = 0; }
+	if(SourceX + Width > Source->Width) { Width = Source->Width - SourceX; }
+	if(SourceY + Height > Source->Height) { Height = Source->Height - SourceY; }
+	if(DestX + Width > Dest->Width) { Width = Dest->Width - DestX; }
+	if(DestY + Height > Dest->Height) { Height = Dest->Height - DestY; }
+	if(Mode == BlitMode_Masked)
+	{
+		Assert(Mask);
+		if(SourceX + Width > Mask->Width) { Width = Mask->Width - SourceX; }
+		if(SourceY + Height > Mask->Height) { Height = Mask->Height - SourceY; }
+	}
+
+	if((Width <= 0) || (Height <= 0))
+	{
+		return;
+	}
+
+	v4 *FirstSourceRow = PixelBufferRow(Source, SourceY) + SourceX;
+	v4 *FirstDestRow = PixelBufferRow(Dest, DestY) + DestX;
+
+	bool32 RowsReversed = false;
+	bool32 PixelsReversed = false;
+	if(Source->Pixels == Dest->Pixels)
+	{
+		Assert(Source->Pitch == Dest->Pitch);
+		if(DestY > SourceY)
+		{
+			RowsReversed = true;
+		}
+		else if((DestY == SourceY) && (DestX > SourceX))
+		{
+			PixelsReversed = true;
+		}
+	}
+
+	__m128 KeyWide = _mm_setr_ps(Key.E[0], Key.E[1], Key.E[2], Key.E[3]);
+	for(int32 Index = 0; Index < Height; ++Index)
+	{
+		int32 Y = (RowsReversed ? (Height - 1 - Index) : Index);
+		v4 *SourceRow = FirstSourceRow + (Y * Source->Pitch);
+		v4 *DestRow = FirstDestRow + (Y * Dest->Pitch);
+		switch(Mode)
+		{
+			case BlitMode_Copy:
+			{
+				BlitRowCopy(DestRow, SourceRow, Width, PixelsReversed);
+			} break;
+			case BlitMode_TransparentKey:
+			{
+				BlitRowTransparentKey(DestRow, SourceRow, Width, KeyWide, PixelsReversed);
+			} break;
+			case BlitMode_Masked:
+			{
+				BlitRowMasked(DestRow, SourceRow, Width, PixelMaskRow(Mask, SourceY + Y), SourceX, PixelsReversed);
+			} break;
+		}
+	}
+}
+
+// NOTE(rick): Sets every pixel under the mask, placed at (X, Y) in Dest, to
+// Color.
+static void
+FillPixelBufferMasked(struct pixel_buffer *Dest, int32 X, int32 Y, struct pixel_mask *Mask, union v4 Color)
+{
+	__m128 ColorWide = _mm_setr_ps(Color.E[0], Color.E[1], Color.E[2], Color.E[3]);
+	for(int32 MaskY = 0; MaskY < Mask->Height; ++MaskY)
+	{
+		int32 DestY = Y + MaskY;
+		if((DestY < 0) || (DestY >= Dest->Height))
+		{
+			continue;
+		}
+
+		int32 MinX = (X < 0) ? -X : 0;
+		int32 MaxX = Mask->Width;
+		if(X + MaxX > Dest->Width) { MaxX = Dest->Width - X; }
+
+		uint32 *MaskRow = PixelMaskRow(Mask, MaskY);
+		v4 *DestRow = PixelBufferRow(Dest, DestY) + X;
+		int32 Bit = MinX;
+		while(Bit < MaxX)
+		{
+			int32 RunStart = FindPixelMaskRunEnd(MaskRow, Bit, MaxX, false);
+			int32 RunEnd = FindPixelMaskRunEnd(MaskRow, RunStart, MaxX, true);
+			for(int32 Pixel = RunStart; Pixel < RunEnd; ++Pixel)
+			{
+				_mm_storeu_ps(DestRow[Pixel].E, ColorWide);
+			}
+			Bit = RunEnd;
+		}
+	}
+}
@@ -0,0 +1,32 @@
+#ifndef PIXEL_EDITOR_BLIT_H
+
+// NOTE(rick): A view over a block of v4 pixels. Pitch is measured in pixels,
+// not bytes, so a sub-rectangle of a larger buffer can be described without
+// copying.
+struct pixel_buffer
+{
+	int32 Width;
+	int32 Height;
+	int32 Pitch;
+	v4 *Pixels;
+};
+
+// NOTE(rick): One bit per pixel, rows padded out to a whole uint32 so a row
+// can be skipped or copied 32 pixels at a time.
+struct pixel_mask
+{
+	int32 Width;
+	int32 Height;
+	int32 WordsPerRow;
+	uint32 *Bits;
+};
+
+enum blit_mode
+{
+	BlitMode_Copy,
+	BlitMode_TransparentKey,
+	BlitMode_Masked,
+};
+
+#define PIXEL_EDITOR_BLIT_H
+#endif
@@ -0,0 +1,377 @@
+// NOTE(rick): Fully saturated, full value colour for Hue, channels in [0, 1].
+static void
+HueToChannels(real32 Hue, real32 *Channels)
+{
+	real32 Sector = (Hue / 60.0f);
+	Sector -= 6.0f * floorf(Sector / 6.0f);
+	real32 Rising = Sector - floorf(Sector);
+	real32 Falling = 1.0f - Rising;
+
+	switch((int32)Sector)
+	{
+		case 0: { Channels[0] = 1.0f; Channels[1] = Rising; Channels[2] = 0.0f; } break;
+		case 1: { Channels[0] = Falling; Channels[1] = 1.0f; Channels[2] = 0.0f; } break;
+		case 2: { Channels[0] = 0.0f; Channels[1] = 1.0f; Channels[2] = Rising; } break;
+		case 3: { Channels[0] = 0.0f; Channels[1] = Falling; Channels[2] = 1.0f; } break;
+		case 4: { Channels[0] = Rising; Channels[1] = 0.0f; Channels[2] = 1.0f; } break;
+		default: { Channels[0] = 1.0f; Channels[1] = 0.0f; Channels[2] = Falling; } break;
+	}
+}
+
+static union v4
+HSVToColor(real32 Hue, real32 Saturation, real32 Value)
+{
+	real32 Channels[3] = {0};
+	HueToChannels(Hue, Channels);
+
+	union v4 Result = {0};
+	for(int32 Channel = 0; Channel < 3; ++Channel)
+	{
+		real32 Level = Value * (1.0f - (Saturation * (1.0f - Channels[Channel])));
+		Result.E[Channel] = floorf((Level * 255.0f) + 0.5f);
+	}
+	Result.a = 0xff;
+	return(Result);
+}
+
+// NOTE(rick): Grays have no hue of their own, they keep the one passed in.
+static void
+ColorToHSV(union v4 Color, real32 *Hue, real32 *Saturation, real32 *Value)
+{
+	real32 R = Color.r / 255.0f;
+	real32 G = Color.g / 255.0f;
+	real32 B = Color.b / 255.0f;
+	real32 Max = R;
+	if(G > Max) { Max = G; }
+	if(B > Max) { Max = B; }
+	real32 Min = R;
+	if(G < Min) { Min = G; }
+	if(B < Min) { Min = B; }
+	real32 Delta = Max - Min;
+
+	*Value = Max;
+	*Saturation = (Max > 0.0f) ? (Delta / Max) : 0.0f;
+	if(Delta > 0.0f)
+	{
+		real32 Result = 0.0f;
+		if(Max == R)
+		{
+			Result = 60.0f * ((G - B) / Delta);
+		}
+		else if(Max == G)
+		{
+			Result = 60.0f * (((B - R) / Delta) + 2.0f);
+		}
+		else
+		{
+			Result = 60.0f * (((R - G) / Delta) + 4.0f);
+		}
+		if(Result < 0.0f)
+		{
+			Result += 360.0f;
+		}
+		*Hue = Result;
+	}
+}
+
+inline static bool32
+ColorsAreEqual(union v4 A, union v4 B)
+{
+	bool32 Result = ((A.r == B.r) && (A.g == B.g) && (A.b == B.b) && (A.a == B.a));
+	return(Result);
+}
+
+static void
+BuildHueStrip(struct color_picker_state *Picker)
+{
+	uint32 *Pixel = Picker->HueStripPixels;
+	for(int32 Y = 0; Y < COLOR_PICKER_SQUARE_SIZE; ++Y)
+	{
+		real32 Hue = (360.0f * (real32)Y) / (real32)COLOR_PICKER_SQUARE_SIZE;
+		uint32 Color = V4ToU32Pixel(HSVToColor(Hue, 1.0f, 1.0f));
+		for(int32 X = 0; X < COLOR_PICKER_HUE_STRIP_WIDTH; ++X)
+		{
+			*Pixel++ = Color;
+		}
+	}
+}
+
+// NOTE(rick): For a fixed hue each channel is linear in saturation along a
+// row, so a row is a start value and a step per channel rather than an HSV
+// conversion per pixel.
+static void
+BuildSaturationValueSquare(struct color_picker_state *Picker)
+{
+	real32 Channels[3] = {0};
+	HueToChannels(Picker->Hue, Channels);
+
+	real32 LastIndex = (real32)(COLOR_PICKER_SQUARE_SIZE - 1);
+	uint32 *Pixel = Picker->SquarePixels;
+	for(int32 Y = 0; Y < COLOR_PICKER_SQUARE_SIZE; ++Y)
+	{
+		real32 Value = 1.0f - ((real32)Y / LastIndex);
+		real32 Level[3];
+		real32 Step[3];
+		for(int32 Channel = 0; Channel < 3; ++Channel)
+		{
+			Level[Channel] = (Value * 255.0f) + 0.5f;
+			Step[Channel] = -(Value * 255.0f * (1.0f - Channels[Channel])) / LastIndex;
+		}
+
+		for(int32 X = 0; X < COLOR_PICKER_SQUARE_SIZE; ++X)
+		{
+			*Pixel++ = (0xff000000 |
+						((uint32)Level[0] << 16) |
+						((uint32)Level[1] << 8) |
+						((uint32)Level[2] << 0));
+			Level[0] += Step[0];
+			Level[1] += Step[1];
+			Level[2] += Step[2];
+		}
+	}
+
+	Picker->SquareHue = Picker->Hue;
+	Picker->SquareValid = true;
+}
+
+static void
+DrawScreenPixels(struct game_screen_buffer *Buffer, int32 X, int32 Y,
+				 uint32 *Pixels, int32 Width, int32 Height)
+{
+	int32 MinX = X;
+	int32 MinY = Y;
+	int32 MaxX = X + Width;
+	int32 MaxY = Y + Height;
+	if(MinX < 0) { MinX = 0; }
+	if(MinY < 0) { MinY = 0; }
+	if(MaxX > Buffer->Width) { MaxX = Buffer->Width; }
+	if(MaxY > Buffer->Height) { MaxY = Buffer->Height; }
+	if((MinX >= MaxX) || (MinY >= MaxY))
+	{
+		return;
+	}
+
+	for(int32 Row = MinY; Row < MaxY; ++Row)
+	{
+		uint32 *Dest = (uint32 *)((uint8 *)Buffer->BitmapMemory + (Row * Buffer->Pitch)) + MinX;
+		uint32 *Source = Pixels + ((Row - Y) * Width) + (MinX - X);
+		memcpy(Dest, Source, (MaxX - MinX) * sizeof(uint32));
+	}
+}
+
+static void
+InitializeColorPicker(struct app_state *AppState)
+{
+	struct color_picker_state *Picker = &AppState->ColorPicker;
+
+	real32 ReadoutHeight = COLOR_PICKER_SWATCH_SIZE;
+	Picker->Dimensions = V2((3 * COLOR_PICKER_PADDING) + COLOR_PICKER_SQUARE_SIZE + COLOR_PICKER_HUE_STRIP_WIDTH,
+							(3 * COLOR_PICKER_PADDING) + COLOR_PICKER_SQUARE_SIZE + ReadoutHeight);
+	Picker->Position = V2(AppState->ColorPickerButton.Position.x,
+						  AppState->ColorPickerButton.Position.y - Picker->Dimensions.y - 6);
+	Picker->SquarePosition = V2(Picker->Position.x + COLOR_PICKER_PADDING,
+								Picker->Position.y + COLOR_PICKER_PADDING);
+	Picker->HueStripPosition = V2(Picker->SquarePosition.x + COLOR_PICKER_SQUARE_SIZE + COLOR_PICKER_PADDING,
+								  Picker->SquarePosition.y);
+	Picker->SwatchPosition = V2(Picker->SquarePosition.x,
+								Picker->SquarePosition.y + COLOR_PICKER_SQUARE_SIZE + COLOR_PICKER_PADDING);
+	Picker->ReadoutPosition = V2(Picker->SwatchPosition.x + COLOR_PICKER_SWATCH_SIZE + COLOR_PICKER_PADDING,
+								 Picker->SwatchPosition.y);
+
+	uint32 SquareSize = COLOR_PICKER_SQUARE_SIZE * COLOR_PICKER_SQUARE_SIZE * sizeof(uint32);
+	uint32 HueStripSize = COLOR_PICKER_HUE_STRIP_WIDTH * COLOR_PICKER_SQUARE_SIZE * sizeof(uint32);
+	Picker->SquarePixels = (uint32 *)AppState->PlatformAllocateMemory(SquareSize);
+	Picker->HueStripPixels = (uint32 *)AppState->PlatformAllocateMemory(HueStripSize);
+	if(Picker->HueStripPixels)
+	{
+		BuildHueStrip(Picker);
+	}
+}
+
+// NOTE(rick): Colours picked here go to the front of the custom colour buttons,
+// pushing the oldest one off the end, unless they are already there.
+static void
+AddCustomColor(struct app_state *AppState, union v4 Color)
+{
+	int32 Count = ArrayCount(AppState->CustomColorButtons);
+	for(int32 Index = 0; Index < Count; ++Index)
+	{
+		if(ColorsAreEqual(AppState->CustomColorButtons[Index].Color, Color))
+		{
+			return;
+		}
+	}
+
+	for(int32 Index = Count - 1; Index > 0; --Index)
+	{
+		AppState->CustomColorButtons[Index].Color = AppState->CustomColorButtons[Index - 1].Color;
+	}
+	AppState->CustomColorButtons[0].Color = Color;
+}
+
+static void
+OpenColorPicker(struct app_state *AppState)
+{
+	struct color_picker_state *Picker = &AppState->ColorPicker;
+	Picker->Open = true;
+	Picker->Drag = ColorPickerDrag_None;
+	Picker->ColorWhenOpened = AppState->PixelColor;
+	ColorToHSV(AppState->PixelColor, &Picker->Hue, &Picker->Saturation, &Picker->Value);
+}
+
+static void
+CloseColorPicker(struct app_state *AppState)
+{
+	struct color_picker_state *Picker = &AppState->ColorPicker;
+	Picker->Open = false;
+	Picker->Drag = ColorPickerDrag_None;
+	if(!ColorsAreEqual(AppState->PixelColor, Picker->ColorWhenOpened))
+	{
+		AddCustomColor(AppState, AppState->PixelColor);
+	}
+}
+
+inline static real32
+Clamp01(real32 Value)
+{
+	real32 Result = Value;
+	if(Result < 0.0f) { Result = 0.0f; }
+	if(Result > 1.0f) { Result = 1.0f; }
+	return(Result);
+}
+
+// NOTE(rick): Returns true when the mouse belongs to the picker this frame, the
+// caller should then keep it away from the canvas and the other buttons.
+static bool32
+UpdateColorPicker(struct app_state *AppState, struct app_input *Input)
+{
+	struct color_picker_state *Picker = &AppState->ColorPicker;
+	bool32 Pressed = ButtonWasPressed(&Input->ButtonPrimary);
+
+	if(ActionPerformedWithinRegion(Pressed, Input->MouseX, Input->MouseY,
+								   AppState->ColorPickerButton.Position.x, AppState->ColorPickerButton.Position.y,
+								   AppState->ColorPickerButton.Dimensions.x, AppState->ColorPickerButton.Dimensions.y))
+	{
+		if(Picker->Open)
+		{
+			CloseColorPicker(AppState);
+		}
+		else
+		{
+			OpenColorPicker(AppState);
+		}
+		Picker->CapturedMouse = true;
+	}
+	else if(Picker->Open && Pressed)
+	{
+		if(ActionPerformedWithinRegion(true, Input->MouseX, Input->MouseY,
+									   Picker->SquarePosition.x, Picker->SquarePosition.y,
+									   COLOR_PICKER_SQUARE_SIZE, COLOR_PICKER_SQUARE_SIZE))
+		{
+			Picker->Drag = ColorPickerDrag_Square;
+		}
+		else if(ActionPerformedWithinRegion(true, Input->MouseX, Input->MouseY,
+											Picker->HueStripPosition.x, Picker->HueStripPosition.y,
+											COLOR_PICKER_HUE_STRIP_WIDTH, COLOR_PICKER_SQUARE_SIZE))
+		{
+			Picker->Drag = ColorPickerDrag_Hue;
+		}
+		else if(!ActionPerformedWithinRegion(true, Input->MouseX, Input->MouseY,
+											 Picker->Position.x, Picker->Position.y,
+											 Picker->Dimensions.x, Picker->Dimensions.y))
+		{
+			CloseColorPicker(AppState);
+		}
+		Picker->CapturedMouse = true;
+	}
+
+	if(Picker->Open)
+	{
+		if(Picker->Drag == ColorPickerDrag_Square)
+		{
+			real32 LastIndex = (real32)(COLOR_PICKER_SQUARE_SIZE - 1);
+			Picker->Saturation = Clamp01((Input->MouseX - Picker->SquarePosition.x) / LastIndex);
+			Picker->Value = 1.0f - Clamp01((Input->MouseY - Picker->SquarePosition.y) / LastIndex);
+			AppState->PixelColor = HSVToColor(Picker->Hue, Picker->Saturation, Picker->Value);
+		}
+		else if(Picker->Drag == ColorPickerDrag_Hue)
+		{
+			real32 Hue = 360.0f * Clamp01((Input->MouseY - Picker->HueStripPosition.y) / COLOR_PICKER_SQUARE_SIZE);
+			Picker->Hue = (Hue >= 360.0f) ? 0.0f : Hue;
+			AppState->PixelColor = HSVToColor(Picker->Hue, Picker->Saturation, Picker->Value);
+		}
+		else if(!ColorsAreEqual(AppState->PixelColor, HSVToColor(Picker->Hue, Picker->Saturation, Picker->Value)))
+		{
+			// NOTE(rick): The colour was changed from somewhere else (quick
+			// switch, eye dropper, eraser), follow it.
+			ColorToHSV(AppState->PixelColor, &Picker->Hue, &Picker->Saturation, &Picker->Value);
+		}
+	}
+
+	bool32 Result = Picker->CapturedMouse;
+	if(!Input->ButtonPrimary.EndedDown)
+	{
+		Picker->Drag = ColorPickerDrag_None;
+		Picker->CapturedMouse = false;
+	}
+
+	return(Result);
+}
+
+static void
+DrawColorPicker(struct game_screen_buffer *Buffer, struct app_state *AppState)
+{
+	struct color_picker_state *Picker = &AppState->ColorPicker;
+	if(!Picker->Open || !Picker->SquarePixels || !Picker->HueStripPixels)
+	{
+		return;
+	}
+
+	if(!Picker->SquareValid || (Picker->SquareHue != Picker->Hue))
+	{
+		BuildSaturationValueSquare(Picker);
+	}
+
+	DrawRectangle(Buffer, Picker->Position.x - 1, Picker->Position.y - 1,
+				  Picker->Dimensions.x + 2, Picker->Dimensions.y + 2, V4(0xdd, 0xdd, 0xdd, 0xff));
+	DrawRectangle(Buffer, Picker->Position.x, Picker->Position.y,
+				  Picker->Dimensions.x, Picker->Dimensions.y, V4(0x22, 0x22, 0x22, 0xff));
+	DrawScreenPixels(Buffer, (int32)Picker->SquarePosition.x, (int32)Picker->SquarePosition.y,
+					 Picker->SquarePixels, COLOR_PICKER_SQUARE_SIZE, COLOR_PICKER_SQUARE_SIZE);
+	DrawScreenPixels(Buffer, (int32)Picker->HueStripPosition.x, (int32)Picker->HueStripPosition.y,
+					 Picker->HueStripPixels, COLOR_PICKER_HUE_STRIP_WIDTH, COLOR_PICKER_SQUARE_SIZE);
+
+	v4 Light = V4(0xff, 0xff, 0xff, 0xff);
+	v4 Dark = V4(0x00, 0x00, 0x00, 0xff);
+	real32 LastIndex = (real32)(COLOR_PICKER_SQUARE_SIZE - 1);
+	real32 MarkerX = Picker->SquarePosition.x + (Picker->Saturation * LastIndex);
+	real32 MarkerY = Picker->SquarePosition.y + ((1.0f - Picker->Value) * LastIndex);
+	DrawRectangle(Buffer, MarkerX - 4, MarkerY - 4, 9, 9, Dark);
+	DrawRectangle(Buffer, MarkerX - 3, MarkerY - 3, 7, 7, Light);
+	DrawRectangle(Buffer, MarkerX - 2, MarkerY - 2, 5, 5, AppState->PixelColor);
+
+	real32 HueY = Picker->HueStripPosition.y + ((Picker->Hue / 360.0f) * COLOR_PICKER_SQUARE_SIZE);
+	DrawRectangle(Buffer, Picker->HueStripPosition.x - 2, HueY - 2, COLOR_PICKER_HUE_STRIP_WIDTH + 4, 5, Dark);
+	DrawRectangle(Buffer, Picker->HueStripPosition.x - 1, HueY - 1, COLOR_PICKER_HUE_STRIP_WIDTH + 2, 3, Light);
+
+	// NOTE(rick): Old colour on the left half of the swatch, new on the right.
+	real32 HalfSwatch = COLOR_PICKER_SWATCH_SIZE / 2;
+	DrawRectangle(Buffer, Picker->SwatchPosition.x, Picker->SwatchPosition.y,
+				  HalfSwatch, COLOR_PICKER_SWATCH_SIZE, Picker->ColorWhenOpened);
+	DrawRectangle(Buffer, Picker->SwatchPosition.x + HalfSwatch, Picker->SwatchPosition.y,
+				  HalfSwatch, COLOR_PICKER_SWATCH_SIZE, AppState->PixelColor);
+
+	char Text[MAX_TEXT_RUN_LENGTH] = {0};
+	v4 Color = AppState->PixelColor;
+	snprintf(Text, sizeof(Text), "#%02X%02X%02X", (int32)Color.r, (int32)Color.g, (int32)Color.b);
+	UpdateTextRun(AppState, &Picker->HexReadout, Text);
+	snprintf(Text, sizeof(Text), "RGB %d %d %d", (int32)Color.r, (int32)Color.g, (int32)Color.b);
+	UpdateTextRun(AppState, &Picker->RGBReadout, Text);
+
+	v4 TextColor = V4(0xcc, 0xcc, 0xcc, 0xff);
+	int32 ReadoutX = (int32)Picker->ReadoutPosition.x;
+	int32 ReadoutY = (int32)Picker->ReadoutPosition.y;
+	DrawTextRun(Buffer, &Picker->HexReadout, ReadoutX, ReadoutY, TextColor);
+	DrawTextRun(Buffer, &Picker->RGBReadout, ReadoutX,
+				ReadoutY + COLOR_PICKER_SWATCH_SIZE - Picker->RGBReadout.Height, TextColor);
+}
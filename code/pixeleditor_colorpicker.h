@@ -0,0 +1,49 @@
+#ifndef PIXEL_EDITOR_COLORPICKER_H
+
+#define COLOR_PICKER_SQUARE_SIZE 200
+#define COLOR_PICKER_HUE_STRIP_WIDTH 20
+#define COLOR_PICKER_PADDING 8
+#define COLOR_PICKER_SWATCH_SIZE 32
+
+enum color_picker_drag
+{
+	ColorPickerDrag_None,
+	ColorPickerDrag_Square,
+	ColorPickerDrag_Hue,
+};
+
+// NOTE(rick): Hue is in degrees, Saturation and Value in [0, 1]. The
+// saturation/value square only depends on the hue, so its pixels are kept in
+// screen format and rebuilt only when the hue moves. The hue strip never
+// changes and is built once.
+struct color_picker_state
+{
+	bool32 Open;
+	enum color_picker_drag Drag;
+	// NOTE(rick): Set while the mouse button that opened, used or closed the
+	// picker is still held so the press doesn't also reach the canvas.
+	bool32 CapturedMouse;
+
+	real32 Hue;
+	real32 Saturation;
+	real32 Value;
+	v4 ColorWhenOpened;
+
+	v2 Position;
+	v2 Dimensions;
+	v2 SquarePosition;
+	v2 HueStripPosition;
+	v2 SwatchPosition;
+	v2 ReadoutPosition;
+
+	bool32 SquareValid;
+	real32 SquareHue;
+	uint32 *SquarePixels;
+	uint32 *HueStripPixels;
+
+	struct text_run HexReadout;
+	struct text_run RGBReadout;
+};
+
+#define PIXEL_EDITOR_COLORPICKER_H
+#endif
@@ -0,0 +1,192 @@
+static void
+ConvertRowToScreenPixels(uint32 *Dest, v4 *Source, int32 Count)
+{
+	for(int32 X = 0; X < Count; ++X)
+	{
+		Dest[X] = V4ToU32Pixel(Source[X]);
+	}
+}
+
+// NOTE(rick): Nearest-neighbour upscale of one row, every source pixel written
+// Scale times. The common power of two scales are done four pixels a store.
+static void
+UpscaleRow(uint32 *Dest, uint32 *Source, int32 Count, int32 Scale)
+{
+	if(Scale == 1)
+	{
+		memcpy(Dest, Source, Count * sizeof(uint32));
+	}
+	else if(Scale == 2)
+	{
+		int32 X = 0;
+		for(; X + 4 <= Count; X += 4)
+		{
+			__m128i Pixels = _mm_loadu_si128((__m128i *)(Source + X));
+			_mm_storeu_si128((__m128i *)(Dest + (X * 2)), _mm_unpacklo_epi32(Pixels, Pixels));
+			_mm_storeu_si128((__m128i *)(Dest + (X * 2) + 4), _mm_unpackhi_epi32(Pixels, Pixels));
+		}
+		for(; X < Count; ++X)
+		{
+			Dest[(X * 2) + 0] = Source[X];
+			Dest[(X * 2) + 1] = Source[X];
+		}
+	}
+	else if((Scale % 4) == 0)
+	{
+		for(int32 X = 0; X < Count; ++X)
+		{
+			__m128i Pixel = _mm_set1_epi32((int32)Source[X]);
+			uint32 *Run = Dest + (X * Scale);
+			for(int32 Index = 0; Index < Scale; Index += 4)
+			{
+				_mm_storeu_si128((__m128i *)(Run + Index), Pixel);
+			}
+		}
+	}
+	else
+	{
+		for(int32 X = 0; X < Count; ++X)
+		{
+			uint32 *Run = Dest + (X * Scale);
+			for(int32 Index = 0; Index < Scale; ++Index)
+			{
+				Run[Index] = Source[X];
+			}
+		}
+	}
+}
+
+static bool32
+BeginExportOutput(struct app_state *AppState, struct export_output *Output, uint32 Width, uint32 Height)
+{
+	Output->Width = Width * Output->Scale;
+	Output->Height = Height * Output->Scale;
+	Output->Failed = true;
+
+	// NOTE(rick): Bitmap sizes are 32-bit and so is PlatformAllocateMemory.
+	uint64 FileSize = sizeof(struct bitmap_header) + ((uint64)Output->Width * Output->Height * sizeof(uint32));
+	uint64 RowsSize = (uint64)Output->Width * Output->Scale * sizeof(uint32);
+	if((FileSize > 0xFFFFFFFF) || (RowsSize > 0xFFFFFFFF))
+	{
+		return(false);
+	}
+
+	Output->Rows = (uint32 *)AppState->PlatformAllocateMemory((uint32)RowsSize);
+	if(!Output->Rows)
+	{
+		return(false);
+	}
+
+	Output->File = AppState->PlatformBeginWriteFile(Output->Filename);
+	if(!Output->File)
+	{
+		return(false);
+	}
+
+	struct bitmap_header BitmapHeader = {0};
+	BitmapHeader.FileType = 0x4D42;
+	BitmapHeader.FileSize = (uint32)FileSize;
+	BitmapHeader.BitmapOffset = sizeof(struct bitmap_header);
+	BitmapHeader.InfoHeader.Size = sizeof(BitmapHeader.InfoHeader);
+	BitmapHeader.InfoHeader.Width = Output->Width;
+	BitmapHeader.InfoHeader.Height = -(int32)Output->Height;
+	BitmapHeader.InfoHeader.Planes = 1;
+	BitmapHeader.InfoHeader.BitsPerPixel = 32;
+	BitmapHeader.InfoHeader.Compression = BI_RGB;
+
+	Output->Failed = !AppState->PlatformAppendToFile(Output->File, &BitmapHeader, sizeof(BitmapHeader));
+	return(!Output->Failed);
+}
+
+static void
+EndExportOutput(struct app_state *AppState, struct export_output *Output)
+{
+	if(Output->File)
+	{
+		if(!AppState->PlatformEndWriteFile(Output->File))
+		{
+			Output->Failed = true;
+		}
+		Output->File = 0;
+	}
+	if(Output->Rows)
+	{
+		AppState->PlatformFreeMemory(Output->Rows);
+		Output->Rows = 0;
+	}
+}
+
+// NOTE(rick): Writes every output in one pass over the canvas. Each source
+// row is converted once, then upscaled into each output's Rows, copied down
+// Scale times and appended as a single write. Returns how many outputs were
+// written completely.
+static int32
+ExportScaledBitmaps(struct app_state *AppState, struct export_output *Outputs, int32 OutputCount)
+{
+	struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+	uint32 *SourceRow = (uint32 *)AppState->PlatformAllocateMemory(Canvas.Width * sizeof(uint32));
+	if(!SourceRow)
+	{
+		return(0);
+	}
+
+	for(int32 OutputIndex = 0; OutputIndex < OutputCount; ++OutputIndex)
+	{
+		BeginExportOutput(AppState, Outputs + OutputIndex, Canvas.Width, Canvas.Height);
+	}
+
+	for(int32 Y = 0; Y < Canvas.Height; ++Y)
+	{
+		ConvertRowToScreenPixels(SourceRow, PixelBufferRow(&Canvas, Y), Canvas.Width);
+		for(int32 OutputIndex = 0; OutputIndex < OutputCount; ++OutputIndex)
+		{
+			struct export_output *Output = Outputs + OutputIndex;
+			if(Output->Failed)
+			{
+				continue;
+			}
+
+			UpscaleRow(Output->Rows, SourceRow, Canvas.Width, Output->Scale);
+			for(int32 Copy = 1; Copy < Output->Scale; ++Copy)
+			{
+				memcpy(Output->Rows + (Copy * Output->Width), Output->Rows, Output->Width * sizeof(uint32));
+			}
+			if(!AppState->PlatformAppendToFile(Output->File, Output->Rows,
+											   Output->Width * Output->Scale * sizeof(uint32)))
+			{
+				Output->Failed = true;
+			}
+		}
+	}
+
+	int32 Result = 0;
+	for(int32 OutputIndex = 0; OutputIndex < OutputCount; ++OutputIndex)
+	{
+		struct export_output *Output = Outputs + OutputIndex;
+		EndExportOutput(AppState, Output);
+		if(!Output->Failed)
+		{
+			++Result;
+		}
+	}
+
+	AppState->PlatformFreeMemory(SourceRow);
+	return(Result);
+}
+
+// NOTE(rick): The storefront set, "Bitmap_1x.bmp" through "Bitmap_8x.bmp".
+static int32
+ExportStandardScales(struct app_state *AppState)
+{
+	int32 Scales[] = {1, 2, 4, 8};
+	struct export_output Outputs[ArrayCount(Scales)] = {0};
+	for(int32 Index = 0; Index < ArrayCount(Scales); ++Index)
+	{
+		Outputs[Index].Scale = Scales[Index];
+		snprintf(Outputs[Index].Filename, sizeof(Outputs[Index].Filename), "Bitmap_%dx.bmp", Scales[Index]);
+	}
+
+	CommitFloatingSelection(AppState);
+	int32 Result = ExportScaledBitmaps(AppState, Outputs, ArrayCount(Outputs));
+	return(Result);
+}
@@ -0,0 +1,21 @@
+#ifndef PIXEL_EDITOR_EXPORT_H
+
+#define MAX_EXPORT_FILENAME_LENGTH 64
+
+// NOTE(rick): One upscaled copy of the canvas being streamed out. Rows holds
+// Scale copies of a single upscaled row, which is everything the output ever
+// keeps in memory.
+struct export_output
+{
+	int32 Scale;
+	char Filename[MAX_EXPORT_FILENAME_LENGTH];
+	void *File;
+	bool32 Failed;
+
+	uint32 Width;
+	uint32 Height;
+	uint32 *Rows;
+};
+
+#define PIXEL_EDITOR_EXPORT_H
+#endif
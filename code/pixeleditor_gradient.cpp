@@ -0,0 +1,227 @@
+// NOTE(rick): 4x4 Bayer matrix as thresholds in (0, 1). A group of four pixels
+// starting on a multiple of four lines up with one row of it, so each row of
+// the matrix is loaded straight into a register.
+static real32 GlobalBayerThresholds[4][4] =
+{
+	{ 0.5f / 16.0f,  8.5f / 16.0f,  2.5f / 16.0f, 10.5f / 16.0f},
+	{12.5f / 16.0f,  4.5f / 16.0f, 14.5f / 16.0f,  6.5f / 16.0f},
+	{ 3.5f / 16.0f, 11.5f / 16.0f,  1.5f / 16.0f,  9.5f / 16.0f},
+	{15.5f / 16.0f,  7.5f / 16.0f, 13.5f / 16.0f,  5.5f / 16.0f},
+};
+
+struct gradient_fill
+{
+	struct pixel_buffer Canvas;
+	struct pixel_mask *Mask;
+	int32 MaskX;
+	int32 MaskY;
+	int32 MinX;
+	int32 MinY;
+	int32 MaxX;
+	int32 MaxY;
+
+	enum gradient_kind Kind;
+	enum gradient_dither Dither;
+	real32 OriginX;
+	real32 OriginY;
+	// NOTE(rick): Linear fills project onto Axis, which is the start to end
+	// vector divided by its squared length so the end lands on exactly 1.
+	real32 AxisX;
+	real32 AxisY;
+	real32 InvRadius;
+	real32 MaxLevel;
+	__m128 Colors[MAX_GRADIENT_STEPS];
+};
+
+static PLATFORM_WORK_CALLBACK(FillGradientRows)
+{
+	struct gradient_fill *Fill = (struct gradient_fill *)Context;
+	int32 MinY = Fill->MinY + (JobIndex * GRADIENT_ROWS_PER_JOB);
+	int32 MaxY = MinY + GRADIENT_ROWS_PER_JOB;
+	if(MaxY > Fill->MaxY) { MaxY = Fill->MaxY; }
+
+	__m128 LaneCenters = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+	__m128 Zero = _mm_setzero_ps();
+	__m128 One = _mm_set1_ps(1.0f);
+	__m128 MaxLevel = _mm_set1_ps(Fill->MaxLevel);
+	__m128 AxisX = _mm_set1_ps(Fill->AxisX);
+	__m128 InvRadius = _mm_set1_ps(Fill->InvRadius);
+	int32 GroupMinX = Fill->MinX & ~3;
+
+	for(int32 Y = MinY; Y < MaxY; ++Y)
+	{
+		v4 *Row = PixelBufferRow(&Fill->Canvas, Y);
+		__m128 Threshold = _mm_set1_ps(0.5f);
+		if(Fill->Dither == GradientDither_Bayer)
+		{
+			Threshold = _mm_loadu_ps(GlobalBayerThresholds[Y & 3]);
+		}
+
+		real32 DeltaY = ((real32)Y + 0.5f) - Fill->OriginY;
+		__m128 RowBase = _mm_set1_ps(DeltaY * Fill->AxisY);
+		__m128 DeltaYSquared = _mm_set1_ps(DeltaY * DeltaY);
+
+		for(int32 X = GroupMinX; X < Fill->MaxX; X += 4)
+		{
+			__m128 DeltaX = _mm_add_ps(_mm_set1_ps((real32)X - Fill->OriginX), LaneCenters);
+			__m128 T;
+			if(Fill->Kind == GradientKind_Linear)
+			{
+				T = _mm_add_ps(_mm_mul_ps(DeltaX, AxisX), RowBase);
+			}
+			else
+			{
+				T = _mm_mul_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(DeltaX, DeltaX), DeltaYSquared)), InvRadius);
+			}
+			T = _mm_min_ps(_mm_max_ps(T, Zero), One);
+
+			__m128 Level = _mm_min_ps(_mm_add_ps(_mm_mul_ps(T, MaxLevel), Threshold), MaxLevel);
+			int32 Levels[4];
+			_mm_storeu_si128((__m128i *)Levels, _mm_cvttps_epi32(Level));
+
+			if(!Fill->Mask && (X >= Fill->MinX) && (X + 4 <= Fill->MaxX))
+			{
+				_mm_storeu_ps(Row[X + 0].E, Fill->Colors[Levels[0]]);
+				_mm_storeu_ps(Row[X + 1].E, Fill->Colors[Levels[1]]);
+				_mm_storeu_ps(Row[X + 2].E, Fill->Colors[Levels[2]]);
+				_mm_storeu_ps(Row[X + 3].E, Fill->Colors[Levels[3]]);
+				continue;
+			}
+
+			for(int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				int32 PixelX = X + Lane;
+				if((PixelX < Fill->MinX) || (PixelX >= Fill->MaxX))
+				{
+					continue;
+				}
+				if(Fill->Mask && !IsPixelMaskSet(Fill->Mask, PixelX - Fill->MaskX, Y - Fill->MaskY))
+				{
+					continue;
+				}
+				_mm_storeu_ps(Row[PixelX].E, Fill->Colors[Levels[Lane]]);
+			}
+		}
+	}
+}
+
+// NOTE(rick): Fills the active selection, or the whole canvas when there is
+// none, with a gradient from the current colour to the quick switch colour.
+static void
+FillGradient(struct app_state *AppState, int32 StartX, int32 StartY, int32 EndX, int32 EndY)
+{
+	struct gradient_state *Gradient = &AppState->Gradient;
+	struct selection_state *Selection = &AppState->Selection;
+
+	struct gradient_fill Fill = {0};
+	Fill.Canvas = PixelMapBuffer(AppState);
+	Fill.MinX = 0;
+	Fill.MinY = 0;
+	Fill.MaxX = Fill.Canvas.Width;
+	Fill.MaxY = Fill.Canvas.Height;
+	if(Selection->Active && !Selection->Floating)
+	{
+		Fill.Mask = &Selection->Mask;
+		Fill.MaskX = Selection->X;
+		Fill.MaskY = Selection->Y;
+		if(Fill.MinX < Selection->X) { Fill.MinX = Selection->X; }
+		if(Fill.MinY < Selection->Y) { Fill.MinY = Selection->Y; }
+		if(Fill.MaxX > Selection->X + Selection->Mask.Width) { Fill.MaxX = Selection->X + Selection->Mask.Width; }
+		if(Fill.MaxY > Selection->Y + Selection->Mask.Height) { Fill.MaxY = Selection->Y + Selection->Mask.Height; }
+	}
+	if((Fill.MinX >= Fill.MaxX) || (Fill.MinY >= Fill.MaxY))
+	{
+		return;
+	}
+
+	Fill.Kind = Gradient->Kind;
+	Fill.Dither = Gradient->Dither;
+	Fill.OriginX = (real32)StartX + 0.5f;
+	Fill.OriginY = (real32)StartY + 0.5f;
+	real32 VectorX = (real32)(EndX - StartX);
+	real32 VectorY = (real32)(EndY - StartY);
+	real32 LengthSquared = (VectorX * VectorX) + (VectorY * VectorY);
+	if(LengthSquared < 1.0f)
+	{
+		LengthSquared = 1.0f;
+	}
+	Fill.AxisX = VectorX / LengthSquared;
+	Fill.AxisY = VectorY / LengthSquared;
+	Fill.InvRadius = 1.0f / sqrtf(LengthSquared);
+
+	int32 Steps = Gradient->Steps;
+	if(Steps < MIN_GRADIENT_STEPS) { Steps = MIN_GRADIENT_STEPS; }
+	if(Steps > MAX_GRADIENT_STEPS) { Steps = MAX_GRADIENT_STEPS; }
+	Fill.MaxLevel = (real32)(Steps - 1);
+
+	v4 From = AppState->PixelColor;
+	v4 To = AppState->QuickSwitchColor.Color;
+	for(int32 Step = 0; Step < Steps; ++Step)
+	{
+		real32 T = (real32)Step / Fill.MaxLevel;
+		v4 Color = {0};
+		for(int32 Channel = 0; Channel < 4; ++Channel)
+		{
+			Color.E[Channel] = floorf(From.E[Channel] + ((To.E[Channel] - From.E[Channel]) * T) + 0.5f);
+		}
+		Fill.Colors[Step] = _mm_loadu_ps(Color.E);
+	}
+
+	uint32 JobCount = ((Fill.MaxY - Fill.MinY) + GRADIENT_ROWS_PER_JOB - 1) / GRADIENT_ROWS_PER_JOB;
+	RunParallel(AppState, FillGradientRows, &Fill, JobCount);
+}
+
+// NOTE(rick): The canvas itself is the preview. Every pixel in the region is
+// rewritten on every fill, so redoing it as the end point moves never leaves
+// traces of the previous one behind.
+static void
+UpdateGradientTool(struct app_state *AppState, struct app_input *Input, bool32 PressedInEditingArea)
+{
+	struct gradient_state *Gradient = &AppState->Gradient;
+
+	int32 GridX = 0;
+	int32 GridY = 0;
+	ScreenToPixelMapGrid(AppState, Input->MouseX, Input->MouseY, &GridX, &GridY);
+
+	if(PressedInEditingArea)
+	{
+		Gradient->Dragging = true;
+		Gradient->StartX = GridX;
+		Gradient->StartY = GridY;
+		Gradient->FilledEndX = GridX + 1;
+	}
+
+	if(Gradient->Dragging)
+	{
+		Gradient->EndX = GridX;
+		Gradient->EndY = GridY;
+		if((Gradient->EndX != Gradient->FilledEndX) || (Gradient->EndY != Gradient->FilledEndY))
+		{
+			FillGradient(AppState, Gradient->StartX, Gradient->StartY, Gradient->EndX, Gradient->EndY);
+			Gradient->FilledEndX = Gradient->EndX;
+			Gradient->FilledEndY = Gradient->EndY;
+		}
+
+		if(!Input->ButtonPrimary.EndedDown)
+		{
+			Gradient->Dragging = false;
+		}
+	}
+}
+
+static void
+DrawGradientGuide(struct game_screen_buffer *Buffer, struct app_state *AppState)
+{
+	struct gradient_state *Gradient = &AppState->Gradient;
+	if(Gradient->Dragging && (AppState->Tool == EditorTool_Gradient))
+	{
+		struct preview_span_context Context = {0};
+		Context.Buffer = Buffer;
+		Context.AppState = AppState;
+		Context.Color = V4(0xdd, 0xdd, 0xdd, 0xff);
+		RasterizeLine(Gradient->StartX, Gradient->StartY, Gradient->EndX, Gradient->EndY,
+					  DrawPreviewSpan, &Context);
+		DrawSelectionOutline(Buffer, AppState, Gradient->StartX, Gradient->StartY, 1, 1);
+		DrawSelectionOutline(Buffer, AppState, Gradient->EndX, Gradient->EndY, 1, 1);
+	}
+}
@@ -0,0 +1,41 @@
+#ifndef PIXEL_EDITOR_GRADIENT_H
+
+enum gradient_kind
+{
+	GradientKind_Linear,
+	GradientKind_Radial,
+};
+
+enum gradient_dither
+{
+	GradientDither_None,
+	GradientDither_Bayer,
+};
+
+// NOTE(rick): The fill is quantized to Steps evenly spaced colours between the
+// two end colours, end colours included.
+#define MIN_GRADIENT_STEPS 2
+#define MAX_GRADIENT_STEPS 16
+
+#define GRADIENT_ROWS_PER_JOB 64
+
+struct gradient_state
+{
+	enum gradient_kind Kind;
+	enum gradient_dither Dither;
+	int32 Steps;
+
+	bool32 Dragging;
+	int32 StartX;
+	int32 StartY;
+	int32 EndX;
+	int32 EndY;
+
+	// NOTE(rick): The end point the canvas was last filled for, the fill is only
+	// redone while dragging when the end point moves to another cell.
+	int32 FilledEndX;
+	int32 FilledEndY;
+};
+
+#define PIXEL_EDITOR_GRADIENT_H
+#endif
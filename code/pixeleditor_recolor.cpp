@@ -0,0 +1,296 @@
+// NOTE(rick): For a pixel of whole values 0-255, RedGreen and BlueAlpha give
+// the entries each half of it is within Tolerance of, one bit per entry, and
+// FirstEntry turns the bits both agree on into the entry that wins.
+struct recolor_lookup
+{
+	uint16 RedGreen[1 << 16];
+	uint16 BlueAlpha[1 << 16];
+	uint8 FirstEntry[1 << MAX_RECOLOR_ENTRIES];
+};
+
+struct recolor_job
+{
+	struct app_state *AppState;
+	struct pixel_buffer Canvas;
+	struct undo_state *Undo;
+	int32 Count;
+	__m128 Tolerance;
+	__m128 From[MAX_RECOLOR_ENTRIES];
+	// NOTE(rick): One extra slot for "no match", which keeps the pixel. A
+	// pixel's new value is (Keep & Pixel) | To for whichever entry it found.
+	__m128 To[MAX_RECOLOR_ENTRIES + 1];
+	__m128 Keep[MAX_RECOLOR_ENTRIES + 1];
+	struct recolor_lookup *Lookup;
+};
+
+// NOTE(rick): All lanes set when every channel of Pixel is within Tolerance of
+// From, all clear otherwise.
+static inline __m128
+RecolorMatchMask(__m128 Pixel, __m128 From, __m128 Tolerance)
+{
+	__m128 Difference = _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_sub_ps(Pixel, From));
+	__m128 Match = _mm_cmple_ps(Difference, Tolerance);
+	Match = _mm_and_ps(Match, _mm_shuffle_ps(Match, Match, _MM_SHUFFLE(2, 3, 0, 1)));
+	Match = _mm_and_ps(Match, _mm_shuffle_ps(Match, Match, _MM_SHUFFLE(1, 0, 3, 2)));
+	return(Match);
+}
+
+// NOTE(rick): Built with the same arithmetic as RecolorMatchMask so the
+// lookup agrees with it exactly.
+static void
+BuildRecolorLookup(struct recolor_job *Job, struct recolor_lookup *Lookup)
+{
+	uint16 ChannelMatches[4][256] = {0};
+	for(int32 Value = 0; Value < 256; ++Value)
+	{
+		__m128 Pixel = _mm_set1_ps((real32)Value);
+		for(int32 Entry = 0; Entry < Job->Count; ++Entry)
+		{
+			__m128 Difference = _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_sub_ps(Pixel, Job->From[Entry]));
+			int32 Channels = _mm_movemask_ps(_mm_cmple_ps(Difference, Job->Tolerance));
+			for(int32 Channel = 0; Channel < 4; ++Channel)
+			{
+				if(Channels & (1 << Channel))
+				{
+					ChannelMatches[Channel][Value] |= (uint16)(1 << Entry);
+				}
+			}
+		}
+	}
+
+	for(int32 High = 0; High < 256; ++High)
+	{
+		for(int32 Low = 0; Low < 256; ++Low)
+		{
+			Lookup->RedGreen[(High << 8) | Low] = ChannelMatches[0][Low] & ChannelMatches[1][High];
+			Lookup->BlueAlpha[(High << 8) | Low] = ChannelMatches[2][Low] & ChannelMatches[3][High];
+		}
+	}
+
+	Lookup->FirstEntry[0] = MAX_RECOLOR_ENTRIES;
+	for(uint32 Matches = 1; Matches < ArrayCount(Lookup->FirstEntry); ++Matches)
+	{
+		Lookup->FirstEntry[Matches] = (Matches & 1) ? 0 : (uint8)(Lookup->FirstEntry[Matches >> 1] + 1);
+	}
+}
+
+// NOTE(rick): Returns the first entry Pixel matches, or MAX_RECOLOR_ENTRIES
+// if there is none.
+static int32
+FindRecolorEntry(struct recolor_job *Job, __m128 Pixel)
+{
+	for(int32 Entry = 0; Entry < Job->Count; ++Entry)
+	{
+		if(_mm_movemask_ps(RecolorMatchMask(Pixel, Job->From[Entry], Job->Tolerance)))
+		{
+			return(Entry);
+		}
+	}
+	return(MAX_RECOLOR_ENTRIES);
+}
+
+// NOTE(rick): FindRecolorEntry for four pixels at once. Canvas colours are
+// almost always whole values 0-255, so the four pixels are packed down to
+// bytes and each one costs three lookups whatever the number of entries.
+// Anything else goes through FindRecolorEntry.
+static inline void
+FindRecolorEntries(struct recolor_job *Job, v4 *Pixels, int32 *Entries)
+{
+	__m128 Pixel0 = _mm_loadu_ps(Pixels[0].E);
+	__m128 Pixel1 = _mm_loadu_ps(Pixels[1].E);
+	__m128 Pixel2 = _mm_loadu_ps(Pixels[2].E);
+	__m128 Pixel3 = _mm_loadu_ps(Pixels[3].E);
+	__m128i Channels0 = _mm_cvttps_epi32(Pixel0);
+	__m128i Channels1 = _mm_cvttps_epi32(Pixel1);
+	__m128i Channels2 = _mm_cvttps_epi32(Pixel2);
+	__m128i Channels3 = _mm_cvttps_epi32(Pixel3);
+
+	__m128 Whole = _mm_and_ps(_mm_and_ps(_mm_cmpeq_ps(_mm_cvtepi32_ps(Channels0), Pixel0),
+										 _mm_cmpeq_ps(_mm_cvtepi32_ps(Channels1), Pixel1)),
+							  _mm_and_ps(_mm_cmpeq_ps(_mm_cvtepi32_ps(Channels2), Pixel2),
+										 _mm_cmpeq_ps(_mm_cvtepi32_ps(Channels3), Pixel3)));
+	__m128i OutOfRange = _mm_and_si128(_mm_or_si128(_mm_or_si128(Channels0, Channels1),
+													_mm_or_si128(Channels2, Channels3)),
+									   _mm_set1_epi32(~0xff));
+	struct recolor_lookup *Lookup = Job->Lookup;
+	if(Lookup &&
+	   (_mm_movemask_ps(Whole) == 0xF) &&
+	   (_mm_movemask_epi8(_mm_cmpeq_epi32(OutOfRange, _mm_setzero_si128())) == 0xFFFF))
+	{
+		__m128i Packed = _mm_packus_epi16(_mm_packs_epi32(Channels0, Channels1),
+										  _mm_packs_epi32(Channels2, Channels3));
+		Entries[0] = Lookup->FirstEntry[Lookup->RedGreen[_mm_extract_epi16(Packed, 0)] &
+										Lookup->BlueAlpha[_mm_extract_epi16(Packed, 1)]];
+		Entries[1] = Lookup->FirstEntry[Lookup->RedGreen[_mm_extract_epi16(Packed, 2)] &
+										Lookup->BlueAlpha[_mm_extract_epi16(Packed, 3)]];
+		Entries[2] = Lookup->FirstEntry[Lookup->RedGreen[_mm_extract_epi16(Packed, 4)] &
+										Lookup->BlueAlpha[_mm_extract_epi16(Packed, 5)]];
+		Entries[3] = Lookup->FirstEntry[Lookup->RedGreen[_mm_extract_epi16(Packed, 6)] &
+										Lookup->BlueAlpha[_mm_extract_epi16(Packed, 7)]];
+	}
+	else
+	{
+		for(int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			Entries[Lane] = FindRecolorEntry(Job, _mm_loadu_ps(Pixels[Lane].E));
+		}
+	}
+}
+
+static inline void
+RecolorPixel(struct recolor_job *Job, v4 *Pixel, int32 Entry)
+{
+	__m128 Value = _mm_loadu_ps(Pixel->E);
+	_mm_storeu_ps(Pixel->E, _mm_or_ps(_mm_and_ps(Job->Keep[Entry], Value), Job->To[Entry]));
+}
+
+// NOTE(rick): One pass per row. Pixels are written four at a time and only
+// when one of the four matched, so cache lines without the colour are never
+// dirtied; within the four the select doesn't branch. The row is saved for
+// undo just before its first write, while it is still untouched.
+static PLATFORM_WORK_CALLBACK(RecolorRows)
+{
+	struct recolor_job *Job = (struct recolor_job *)Context;
+	int32 MinY = JobIndex * RECOLOR_ROWS_PER_JOB;
+	int32 MaxY = MinY + RECOLOR_ROWS_PER_JOB;
+	if(MaxY > Job->Canvas.Height) { MaxY = Job->Canvas.Height; }
+
+	for(int32 Y = MinY; Y < MaxY; ++Y)
+	{
+		v4 *Row = PixelBufferRow(&Job->Canvas, Y);
+		v4 *NextRow = PixelBufferRow(&Job->Canvas, (Y + 1 < MaxY) ? (Y + 1) : Y);
+		bool32 Changed = false;
+		int32 X = 0;
+		for(; X < Job->Canvas.Width; X += 4)
+		{
+			// NOTE(rick): Four pixels are a cache line. Fetching the next row's
+			// line now keeps memory busy while this row is worked on.
+			_mm_prefetch((char *)(NextRow + X), _MM_HINT_T0);
+
+			int32 Entries[4] = {MAX_RECOLOR_ENTRIES, MAX_RECOLOR_ENTRIES, MAX_RECOLOR_ENTRIES, MAX_RECOLOR_ENTRIES};
+			int32 Count = Job->Canvas.Width - X;
+			if(Count >= 4)
+			{
+				FindRecolorEntries(Job, Row + X, Entries);
+			}
+			else
+			{
+				for(int32 Lane = 0; Lane < Count; ++Lane)
+				{
+					Entries[Lane] = FindRecolorEntry(Job, _mm_loadu_ps(Row[X + Lane].E));
+				}
+			}
+
+			// NOTE(rick): Entries are all below MAX_RECOLOR_ENTRIES, a power of
+			// two, so its bit survives the and only if none of the four matched.
+			if(!(Entries[0] & Entries[1] & Entries[2] & Entries[3] & MAX_RECOLOR_ENTRIES))
+			{
+				if(!Changed)
+				{
+					if(Job->Undo)
+					{
+						SaveUndoRow(Job->AppState, Job->Undo, &Job->Canvas, Y);
+					}
+					Changed = true;
+				}
+
+				Count = (Count < 4) ? Count : 4;
+				for(int32 Lane = 0; Lane < Count; ++Lane)
+				{
+					RecolorPixel(Job, Row + X + Lane, Entries[Lane]);
+				}
+			}
+		}
+
+		if(Changed && Job->Undo)
+		{
+			FinishUndoRow(Job->Undo, &Job->Canvas, Y);
+		}
+	}
+}
+
+static void
+RecolorCanvas(struct app_state *AppState, struct recolor_table *Table)
+{
+	if(Table->Count <= 0)
+	{
+		return;
+	}
+	CommitFloatingSelection(AppState);
+
+	struct recolor_job Job = {0};
+	Job.AppState = AppState;
+	Job.Canvas = PixelMapBuffer(AppState);
+	Job.Count = (Table->Count < MAX_RECOLOR_ENTRIES) ? Table->Count : MAX_RECOLOR_ENTRIES;
+	Job.Tolerance = _mm_set1_ps(Table->Tolerance);
+	for(int32 Entry = 0; Entry < Job.Count; ++Entry)
+	{
+		Job.From[Entry] = _mm_loadu_ps(Table->Entries[Entry].From.E);
+		Job.To[Entry] = _mm_loadu_ps(Table->Entries[Entry].To.E);
+	}
+	Job.Keep[MAX_RECOLOR_ENTRIES] = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+	// NOTE(rick): Without the lookup every pixel is tested entry by entry,
+	// which gives the same result, just slower.
+	Job.Lookup = (struct recolor_lookup *)AppState->PlatformAllocateMemory(sizeof(struct recolor_lookup));
+	if(Job.Lookup)
+	{
+		BuildRecolorLookup(&Job, Job.Lookup);
+	}
+
+	if(BeginUndoableEdit(AppState))
+	{
+		Job.Undo = &AppState->Undo;
+	}
+
+	uint32 JobCount = (Job.Canvas.Height + RECOLOR_ROWS_PER_JOB - 1) / RECOLOR_ROWS_PER_JOB;
+	RunParallel(AppState, RecolorRows, &Job, JobCount);
+
+	if(Job.Undo)
+	{
+		EndUndoableEdit(AppState);
+	}
+	if(Job.Lookup)
+	{
+		AppState->PlatformFreeMemory(Job.Lookup);
+	}
+}
+
+// NOTE(rick): Replaces the colour of the cell under the mouse with the current
+// colour across the whole canvas.
+static void
+ReplaceColorUnderCursor(struct app_state *AppState, struct app_input *Input)
+{
+	v4 *Pixel = GetPixelMapPixelColor(AppState, Input->MouseX, Input->MouseY);
+	if(Pixel)
+	{
+		struct recolor_table Table = {0};
+		Table.Count = 1;
+		Table.Tolerance = AppState->RecolorTolerance;
+		Table.Entries[0].From = *Pixel;
+		Table.Entries[0].To = AppState->PixelColor;
+		RecolorCanvas(AppState, &Table);
+	}
+}
+
+// NOTE(rick): The first row of custom colour buttons maps onto the second row,
+// column for column. Columns holding the same colour twice are left out.
+static void
+SwapPaletteFromCustomColors(struct app_state *AppState)
+{
+	int32 Columns = ArrayCount(AppState->CustomColorButtons) / 2;
+	struct recolor_table Table = {0};
+	Table.Tolerance = AppState->RecolorTolerance;
+	for(int32 Column = 0; Column < Columns; ++Column)
+	{
+		v4 From = AppState->CustomColorButtons[Column].Color;
+		v4 To = AppState->CustomColorButtons[Column + Columns].Color;
+		if(!ColorsAreEqual(From, To))
+		{
+			struct recolor_entry *Entry = Table.Entries + Table.Count++;
+			Entry->From = From;
+			Entry->To = To;
+		}
+	}
+	RecolorCanvas(AppState, &Table);
+}
@@ -0,0 +1,24 @@
+#ifndef PIXEL_EDITOR_RECOLOR_H
+
+#define MAX_RECOLOR_ENTRIES 16
+// NOTE(rick): A multiple of UNDO_ROWS_PER_BAND, so no two jobs share a band.
+#define RECOLOR_ROWS_PER_JOB 64
+
+// NOTE(rick): A pixel matches an entry when every channel is within Tolerance
+// of From. Entries are tested against the original pixel in order and the
+// first match wins, so swaps like A->B, B->A work.
+struct recolor_entry
+{
+	v4 From;
+	v4 To;
+};
+
+struct recolor_table
+{
+	int32 Count;
+	real32 Tolerance;
+	struct recolor_entry Entries[MAX_RECOLOR_ENTRIES];
+};
+
+#define PIXEL_EDITOR_RECOLOR_H
+#endif
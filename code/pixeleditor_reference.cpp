@@ -0,0 +1,351 @@
+static void
+FreeReferenceImage(struct app_state *AppState)
+{
+	struct reference_state *Reference = &AppState->Reference;
+	if(Reference->Pixels)
+	{
+		AppState->PlatformFreeMemory(Reference->Pixels);
+		Reference->Pixels = 0;
+	}
+	Reference->Width = 0;
+	Reference->Height = 0;
+	Reference->ViewValid = false;
+}
+
+// NOTE(rick): Reads an uncompressed 24 or 32-bit bitmap, top-down or
+// bottom-up. 32-bit files written with bitfields are assumed to use the usual
+// BGRA masks. The reference starts out fitted to the canvas.
+static bool32
+LoadReferenceImage(struct app_state *AppState, char *Filename)
+{
+	struct reference_state *Reference = &AppState->Reference;
+	bool32 Result = false;
+
+	struct platform_file_contents File = AppState->PlatformReadEntireFile(Filename);
+	if(!File.Data)
+	{
+		return(false);
+	}
+
+	// NOTE(rick): The header fields can't be looked at until we know the file
+	// holds a whole header.
+	if(File.Size < sizeof(struct bitmap_header))
+	{
+		AppState->PlatformFreeMemory(File.Data);
+		return(false);
+	}
+
+	struct bitmap_header *Header = (struct bitmap_header *)File.Data;
+	int32 BitsPerPixel = Header->InfoHeader.BitsPerPixel;
+	int32 Width = Header->InfoHeader.Width;
+	int32 Height = (Header->InfoHeader.Height < 0) ? -Header->InfoHeader.Height : Header->InfoHeader.Height;
+	bool32 BottomUp = (Header->InfoHeader.Height > 0);
+	int32 BitFields = 3;
+	uint64 Pitch = ((((uint64)Width * BitsPerPixel) / 8) + 3) & ~3;
+
+	if((Header->FileType == 0x4D42) &&
+	   ((BitsPerPixel == 24) || (BitsPerPixel == 32)) &&
+	   ((Header->InfoHeader.Compression == BI_RGB) ||
+		((BitsPerPixel == 32) && (Header->InfoHeader.Compression == BitFields))) &&
+	   (Width > 0) && (Height > 0) &&
+	   ((uint64)Width * Height * sizeof(uint32) <= 0xFFFFFFFF) &&
+	   ((uint64)Header->BitmapOffset + (Pitch * Height) <= File.Size))
+	{
+		uint32 *Pixels = (uint32 *)AppState->PlatformAllocateMemory(Width * Height * sizeof(uint32));
+		if(Pixels)
+		{
+			int32 BytesPerPixel = BitsPerPixel / 8;
+			uint8 *Base = (uint8 *)File.Data + Header->BitmapOffset;
+			for(int32 Y = 0; Y < Height; ++Y)
+			{
+				uint8 *Source = Base + ((BottomUp ? (Height - 1 - Y) : Y) * Pitch);
+				uint32 *Dest = Pixels + (Y * Width);
+				for(int32 X = 0; X < Width; ++X)
+				{
+					Dest[X] = (0xff << 24) | (Source[2] << 16) | (Source[1] << 8) | (Source[0] << 0);
+					Source += BytesPerPixel;
+				}
+			}
+
+			FreeReferenceImage(AppState);
+			Reference->Pixels = Pixels;
+			Reference->Width = Width;
+			Reference->Height = Height;
+			Reference->Offset = V2(0.0f, 0.0f);
+			real32 ScaleX = (real32)AppState->PixelMapWidth / (real32)Width;
+			real32 ScaleY = (real32)AppState->PixelMapHeight / (real32)Height;
+			Reference->Scale = (ScaleX < ScaleY) ? ScaleX : ScaleY;
+			Reference->Opacity = REFERENCE_DEFAULT_OPACITY;
+			if(Reference->Mode == ReferenceMode_Off)
+			{
+				Reference->Mode = ReferenceMode_Underlay;
+			}
+			Result = true;
+		}
+	}
+
+	AppState->PlatformFreeMemory(File.Data);
+	return(Result);
+}
+
+static const char *
+ReferenceModeName(enum reference_mode Mode)
+{
+	const char *Result = "Off";
+	switch(Mode)
+	{
+		case ReferenceMode_Underlay: { Result = "Underlay"; } break;
+		case ReferenceMode_Overlay: { Result = "Overlay"; } break;
+		default: {} break;
+	}
+	return(Result);
+}
+
+static void
+CycleReferenceMode(struct app_state *AppState)
+{
+	struct reference_state *Reference = &AppState->Reference;
+	if(Reference->Pixels)
+	{
+		Reference->Mode = (enum reference_mode)((Reference->Mode + 1) % ReferenceMode_Count);
+	}
+}
+
+static void
+AdjustReferenceOpacity(struct app_state *AppState, real32 Delta)
+{
+	struct reference_state *Reference = &AppState->Reference;
+	Reference->Opacity += Delta;
+	if(Reference->Opacity < REFERENCE_OPACITY_STEP) { Reference->Opacity = REFERENCE_OPACITY_STEP; }
+	if(Reference->Opacity > 1.0f) { Reference->Opacity = 1.0f; }
+}
+
+static void
+ScaleReference(struct app_state *AppState, real32 Factor)
+{
+	struct reference_state *Reference = &AppState->Reference;
+	if(Reference->Pixels)
+	{
+		Reference->Scale *= Factor;
+	}
+}
+
+static void
+NudgeReference(struct app_state *AppState, real32 CellsX, real32 CellsY)
+{
+	struct reference_state *Reference = &AppState->Reference;
+	Reference->Offset.x += CellsX;
+	Reference->Offset.y += CellsY;
+}
+
+// NOTE(rick): Four screen pixels at a time, every channel times Weight / 256.
+static inline __m128i
+ScaleScreenPixels(__m128i Pixels, __m128i Weight)
+{
+	__m128i Zero = _mm_setzero_si128();
+	__m128i Low = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(Pixels, Zero), Weight), 8);
+	__m128i High = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(Pixels, Zero), Weight), 8);
+	__m128i Result = _mm_packus_epi16(Low, High);
+	return(Result);
+}
+
+static inline int32
+ReferenceOpacityWeight(real32 Opacity)
+{
+	int32 Result = (int32)((Opacity * 256.0f) + 0.5f);
+	if(Result < 0) { Result = 0; }
+	if(Result > 256) { Result = 256; }
+	return(Result);
+}
+
+struct reference_view_job
+{
+	struct app_state *AppState;
+	__m128i Weight;
+};
+
+static PLATFORM_WORK_CALLBACK(BuildReferenceViewRows)
+{
+	struct reference_view_job *Job = (struct reference_view_job *)Context;
+	struct app_state *AppState = Job->AppState;
+	struct reference_state *Reference = &AppState->Reference;
+
+	int32 MinY = JobIndex * REFERENCE_ROWS_PER_JOB;
+	int32 MaxY = MinY + REFERENCE_ROWS_PER_JOB;
+	if(MaxY > Reference->ViewHeight) { MaxY = Reference->ViewHeight; }
+
+	__m128i Covered = _mm_set1_epi32(0xff000000);
+	for(int32 Y = MinY; Y < MaxY; ++Y)
+	{
+		uint32 *Dest = Reference->View + (Y * Reference->ViewWidth);
+		real32 CellY = ((Y + 0.5f) / AppState->PixelMapZoom) - AppState->EditingAreaMapOffset.y;
+		int32 SourceY = (int32)floorf((CellY - Reference->Offset.y) / Reference->Scale);
+		if((CellY < 0.0f) || (CellY >= AppState->PixelMapHeight) ||
+		   (SourceY < 0) || (SourceY >= Reference->Height))
+		{
+			memset(Dest, 0, Reference->ViewWidth * sizeof(uint32));
+			continue;
+		}
+
+		uint32 *SourceRow = Reference->Pixels + (SourceY * Reference->Width);
+		int32 X = 0;
+		for(; X + 4 <= Reference->ViewWidth; X += 4)
+		{
+			int32 *Columns = Reference->ViewColumns + X;
+			uint32 Sampled[4];
+			for(int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				Sampled[Lane] = (Columns[Lane] >= 0) ? SourceRow[Columns[Lane]] : 0;
+			}
+			__m128i Pixels = _mm_loadu_si128((__m128i *)Sampled);
+			__m128i Mask = _mm_srai_epi32(Pixels, 31);
+			Pixels = _mm_or_si128(_mm_andnot_si128(Covered, ScaleScreenPixels(Pixels, Job->Weight)),
+								  _mm_and_si128(Covered, Mask));
+			_mm_storeu_si128((__m128i *)(Dest + X), Pixels);
+		}
+		for(; X < Reference->ViewWidth; ++X)
+		{
+			int32 Column = Reference->ViewColumns[X];
+			uint32 Pixels = (Column >= 0) ? SourceRow[Column] : 0;
+			__m128i Scaled = ScaleScreenPixels(_mm_cvtsi32_si128((int32)Pixels), Job->Weight);
+			Dest[X] = (Column >= 0) ? (((uint32)_mm_cvtsi128_si32(Scaled) & 0x00ffffff) | 0xff000000) : 0;
+		}
+	}
+}
+
+// NOTE(rick): Only the visible part of the reference is ever resampled, one
+// nearest-neighbour lookup per editing area pixel, so the cost doesn't depend
+// on how large the reference image is.
+static void
+BuildReferenceView(struct app_state *AppState)
+{
+	struct reference_state *Reference = &AppState->Reference;
+	int32 ViewWidth = (int32)AppState->EditingAreaSize.x;
+	int32 ViewHeight = (int32)AppState->EditingAreaSize.y;
+	if(!Reference->View || (Reference->ViewWidth != ViewWidth) || (Reference->ViewHeight != ViewHeight))
+	{
+		if(Reference->View) { AppState->PlatformFreeMemory(Reference->View); }
+		if(Reference->ViewColumns) { AppState->PlatformFreeMemory(Reference->ViewColumns); }
+		Reference->View = (uint32 *)AppState->PlatformAllocateMemory(ViewWidth * ViewHeight * sizeof(uint32));
+		Reference->ViewColumns = (int32 *)AppState->PlatformAllocateMemory(ViewWidth * sizeof(int32));
+		Reference->ViewWidth = ViewWidth;
+		Reference->ViewHeight = ViewHeight;
+		if(!Reference->View || !Reference->ViewColumns)
+		{
+			Reference->ViewValid = false;
+			return;
+		}
+	}
+
+	for(int32 X = 0; X < ViewWidth; ++X)
+	{
+		real32 CellX = ((X + 0.5f) / AppState->PixelMapZoom) - AppState->EditingAreaMapOffset.x;
+		int32 SourceX = (int32)floorf((CellX - Reference->Offset.x) / Reference->Scale);
+		Reference->ViewColumns[X] = ((CellX >= 0.0f) && (CellX < AppState->PixelMapWidth) &&
+									 (SourceX >= 0) && (SourceX < Reference->Width)) ? SourceX : -1;
+	}
+
+	struct reference_view_job Job = {0};
+	Job.AppState = AppState;
+	Job.Weight = _mm_set1_epi16((int16)ReferenceOpacityWeight(Reference->Opacity));
+	uint32 JobCount = (ViewHeight + REFERENCE_ROWS_PER_JOB - 1) / REFERENCE_ROWS_PER_JOB;
+	RunParallel(AppState, BuildReferenceViewRows, &Job, JobCount);
+
+	Reference->ViewValid = true;
+}
+
+static struct reference_view_key
+CurrentReferenceViewKey(struct app_state *AppState)
+{
+	struct reference_view_key Result = {0};
+	Result.Zoom = AppState->PixelMapZoom;
+	Result.MapOffset = AppState->EditingAreaMapOffset;
+	Result.Offset = AppState->Reference.Offset;
+	Result.Scale = AppState->Reference.Scale;
+	Result.Opacity = AppState->Reference.Opacity;
+	Result.CanvasWidth = AppState->PixelMapWidth;
+	Result.CanvasHeight = AppState->PixelMapHeight;
+	return(Result);
+}
+
+// NOTE(rick): Called right after the canvas cells are drawn. The view is
+// reused as long as nothing it depends on has changed, so a frame that only
+// paints costs one pass of integer blending over the editing area.
+static void
+DrawReference(struct game_screen_buffer *Buffer, struct app_state *AppState)
+{
+	struct reference_state *Reference = &AppState->Reference;
+	if((Reference->Mode == ReferenceMode_Off) || !Reference->Pixels)
+	{
+		return;
+	}
+
+	struct reference_view_key Key = CurrentReferenceViewKey(AppState);
+	if(!Reference->ViewValid || (memcmp(&Key, &Reference->ViewKey, sizeof(Key)) != 0))
+	{
+		BuildReferenceView(AppState);
+		Reference->ViewKey = Key;
+		if(!Reference->ViewValid)
+		{
+			return;
+		}
+	}
+
+	int32 MinX = (int32)AppState->EditingAreaOffset.x;
+	int32 MinY = (int32)AppState->EditingAreaOffset.y;
+	int32 MaxX = MinX + Reference->ViewWidth;
+	int32 MaxY = MinY + Reference->ViewHeight;
+	if(MinX < 0) { MinX = 0; }
+	if(MinY < 0) { MinY = 0; }
+	if(MaxX > Buffer->Width) { MaxX = Buffer->Width; }
+	if(MaxY > Buffer->Height) { MaxY = Buffer->Height; }
+
+	// NOTE(rick): A cell is empty when its canvas alpha is 0; fresh canvases,
+	// the eraser, reset and cleared selections all leave that. Cells are drawn
+	// with their canvas alpha in the top byte and grid lines are opaque, so
+	// the underlay goes exactly where that byte is 0 whatever colour a cell is.
+	__m128i Alpha = _mm_set1_epi32(0xff000000);
+	__m128i InverseWeight = _mm_set1_epi16((int16)(256 - ReferenceOpacityWeight(Reference->Opacity)));
+	bool32 Overlay = (Reference->Mode == ReferenceMode_Overlay);
+	for(int32 Y = MinY; Y < MaxY; ++Y)
+	{
+		uint32 *Dest = (uint32 *)((uint8 *)Buffer->BitmapMemory + (Y * Buffer->Pitch));
+		uint32 *View = Reference->View + ((Y - (int32)AppState->EditingAreaOffset.y) * Reference->ViewWidth) -
+			(int32)AppState->EditingAreaOffset.x;
+		int32 X = MinX;
+		for(; X + 4 <= MaxX; X += 4)
+		{
+			__m128i Existing = _mm_loadu_si128((__m128i *)(Dest + X));
+			__m128i Sample = _mm_loadu_si128((__m128i *)(View + X));
+			__m128i Covered = _mm_srai_epi32(Sample, 31);
+			__m128i Blended;
+			if(Overlay)
+			{
+				Blended = _mm_or_si128(_mm_adds_epu8(ScaleScreenPixels(Existing, InverseWeight), Sample), Alpha);
+			}
+			else
+			{
+				Covered = _mm_and_si128(Covered, _mm_cmpeq_epi32(_mm_and_si128(Existing, Alpha), _mm_setzero_si128()));
+				Blended = Sample;
+			}
+			_mm_storeu_si128((__m128i *)(Dest + X),
+							 _mm_or_si128(_mm_and_si128(Covered, Blended), _mm_andnot_si128(Covered, Existing)));
+		}
+		for(; X < MaxX; ++X)
+		{
+			uint32 Sample = View[X];
+			if(Sample & 0xff000000)
+			{
+				if(Overlay)
+				{
+					__m128i Scaled = ScaleScreenPixels(_mm_cvtsi32_si128((int32)Dest[X]), InverseWeight);
+					Dest[X] = (uint32)_mm_cvtsi128_si32(_mm_or_si128(_mm_adds_epu8(Scaled, _mm_cvtsi32_si128((int32)Sample)), Alpha));
+				}
+				else if((Dest[X] & 0xff000000) == 0)
+				{
+					Dest[X] = Sample;
+				}
+			}
+		}
+	}
+}
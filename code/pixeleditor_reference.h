@@ -0,0 +1,56 @@
+#ifndef PIXEL_EDITOR_REFERENCE_H
+
+#define REFERENCE_ROWS_PER_JOB 32
+#define REFERENCE_OPACITY_STEP 0.1f
+#define REFERENCE_SCALE_STEP 1.25f
+#define REFERENCE_DEFAULT_OPACITY 0.5f
+
+enum reference_mode
+{
+	ReferenceMode_Off,
+	// NOTE(rick): Shows through empty cells, the ones with zero alpha.
+	ReferenceMode_Underlay,
+	// NOTE(rick): Blended over every cell it covers.
+	ReferenceMode_Overlay,
+
+	ReferenceMode_Count,
+};
+
+// NOTE(rick): Everything the cached view depends on. The view is rebuilt
+// whenever any of it differs from what the view was built with.
+struct reference_view_key
+{
+	real32 Zoom;
+	v2 MapOffset;
+	v2 Offset;
+	real32 Scale;
+	real32 Opacity;
+	uint32 CanvasWidth;
+	uint32 CanvasHeight;
+};
+
+// NOTE(rick): Offset is in canvas cells and Scale in canvas cells per
+// reference pixel. View holds one screen pixel per editing area pixel with
+// the reference already scaled, positioned and multiplied by Opacity; its
+// alpha is 0xff where the reference covers the canvas and 0 elsewhere.
+struct reference_state
+{
+	enum reference_mode Mode;
+	int32 Width;
+	int32 Height;
+	uint32 *Pixels;
+
+	v2 Offset;
+	real32 Scale;
+	real32 Opacity;
+
+	bool32 ViewValid;
+	struct reference_view_key ViewKey;
+	int32 ViewWidth;
+	int32 ViewHeight;
+	uint32 *View;
+	int32 *ViewColumns;
+};
+
+#define PIXEL_EDITOR_REFERENCE_H
+#endif
@@ -0,0 +1,162 @@
+static void
+HashCanvasTiles(struct pixel_buffer *Canvas, uint64 *Hashes, int32 TilesX, int32 TilesY)
+{
+	v4 Tile[TILE_PIXEL_COUNT];
+	for(int32 TileY = 0; TileY < TilesY; ++TileY)
+	{
+		for(int32 TileX = 0; TileX < TilesX; ++TileX)
+		{
+			GatherTile(Tile, Canvas, TileX, TileY);
+			*Hashes++ = HashTilePixels(Tile);
+		}
+	}
+}
+
+// NOTE(rick): The working file is an uncompressed top-down 32-bit bitmap, so
+// every canvas pixel has a fixed offset in it. Rows of changed tiles are
+// converted and written straight over their old bytes, with horizontally
+// adjacent changed tiles merged into one write per pixel row.
+static bool32
+WriteChangedTiles(char *Filename, struct app_state *AppState, struct pixel_buffer *Canvas,
+				  uint64 *NewHashes, uint32 DirtyTileCount)
+{
+	struct save_state *Save = &AppState->Save;
+	bool32 Result = false;
+
+	uint32 *PixelData = (uint32 *)AppState->PlatformAllocateMemory(DirtyTileCount * TILE_PIXEL_COUNT * sizeof(uint32));
+	struct platform_file_range *Ranges = (struct platform_file_range *)
+		AppState->PlatformAllocateMemory(DirtyTileCount * TILE_SIZE * sizeof(struct platform_file_range));
+	if(PixelData && Ranges)
+	{
+		uint32 *Dest = PixelData;
+		uint32 RangeCount = 0;
+		for(int32 TileY = 0; TileY < Save->TilesY; ++TileY)
+		{
+			int32 MinY = TileY * TILE_SIZE;
+			int32 MaxY = MinY + TILE_SIZE;
+			if(MaxY > Canvas->Height) { MaxY = Canvas->Height; }
+			for(int32 Y = MinY; Y < MaxY; ++Y)
+			{
+				v4 *Row = PixelBufferRow(Canvas, Y);
+				int32 TileX = 0;
+				while(TileX < Save->TilesX)
+				{
+					uint32 TileIndex = (TileY * Save->TilesX) + TileX;
+					if(NewHashes[TileIndex] == Save->TileHashes[TileIndex])
+					{
+						++TileX;
+						continue;
+					}
+
+					int32 RunEnd = TileX + 1;
+					while((RunEnd < Save->TilesX) &&
+						  (NewHashes[TileIndex + (RunEnd - TileX)] != Save->TileHashes[TileIndex + (RunEnd - TileX)]))
+					{
+						++RunEnd;
+					}
+
+					int32 MinX = TileX * TILE_SIZE;
+					int32 MaxX = RunEnd * TILE_SIZE;
+					if(MaxX > Canvas->Width) { MaxX = Canvas->Width; }
+
+					struct platform_file_range *Range = Ranges + RangeCount++;
+					Range->Offset = sizeof(struct bitmap_header) + ((((uint64)Y * Canvas->Width) + MinX) * sizeof(uint32));
+					Range->Data = Dest;
+					Range->Size = (MaxX - MinX) * sizeof(uint32);
+					for(int32 X = MinX; X < MaxX; ++X)
+					{
+						*Dest++ = V4ToU32Pixel(Row[X]);
+					}
+
+					TileX = RunEnd;
+				}
+			}
+		}
+
+		uint64 FileSize = sizeof(struct bitmap_header) + ((uint64)Canvas->Width * Canvas->Height * sizeof(uint32));
+		Result = AppState->PlatformWriteFileRanges(Filename, FileSize, Ranges, RangeCount);
+		if(Result)
+		{
+			Save->LastSaveBytesWritten = (uint32)((uint8 *)Dest - (uint8 *)PixelData);
+		}
+	}
+
+	if(PixelData) { AppState->PlatformFreeMemory(PixelData); }
+	if(Ranges) { AppState->PlatformFreeMemory(Ranges); }
+	return(Result);
+}
+
+// NOTE(rick): Saves the canvas to Filename, rewriting only the tiles that
+// changed since the last successful save when the file on disk still has the
+// same layout. Falls back to a full ExportBitmap otherwise.
+static bool32
+SaveCanvas(char *Filename, struct app_state *AppState)
+{
+	struct save_state *Save = &AppState->Save;
+	struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+	int32 TilesX = (Canvas.Width + TILE_SIZE - 1) / TILE_SIZE;
+	int32 TilesY = (Canvas.Height + TILE_SIZE - 1) / TILE_SIZE;
+	uint32 TileCount = TilesX * TilesY;
+
+	uint64 *NewHashes = (uint64 *)AppState->PlatformAllocateMemory(TileCount * sizeof(uint64));
+	if(!NewHashes)
+	{
+		return(false);
+	}
+	HashCanvasTiles(&Canvas, NewHashes, TilesX, TilesY);
+
+	bool32 Result = false;
+	if(Save->HasSavedFile && AppState->PlatformWriteFileRanges &&
+	   (Save->SavedWidth == Canvas.Width) && (Save->SavedHeight == Canvas.Height))
+	{
+		uint32 DirtyTileCount = 0;
+		for(uint32 TileIndex = 0; TileIndex < TileCount; ++TileIndex)
+		{
+			if(NewHashes[TileIndex] != Save->TileHashes[TileIndex])
+			{
+				++DirtyTileCount;
+			}
+		}
+
+		if(DirtyTileCount == 0)
+		{
+			Save->LastSaveBytesWritten = 0;
+			Result = true;
+		}
+		else if(DirtyTileCount <= (uint32)(TileCount * INCREMENTAL_SAVE_MAX_DIRTY_FRACTION))
+		{
+			Result = WriteChangedTiles(Filename, AppState, &Canvas, NewHashes, DirtyTileCount);
+		}
+		Save->LastSaveTileCount = DirtyTileCount;
+	}
+
+	if(!Result)
+	{
+		Result = ExportBitmap(Filename, Canvas.Pixels, Canvas.Width, Canvas.Height, AppState);
+		if(Result)
+		{
+			Save->LastSaveTileCount = TileCount;
+			Save->LastSaveBytesWritten = sizeof(struct bitmap_header) + (Canvas.Width * Canvas.Height * sizeof(uint32));
+		}
+	}
+
+	if(Result)
+	{
+		if(Save->TileHashes)
+		{
+			AppState->PlatformFreeMemory(Save->TileHashes);
+		}
+		Save->TileHashes = NewHashes;
+		Save->TilesX = TilesX;
+		Save->TilesY = TilesY;
+		Save->SavedWidth = Canvas.Width;
+		Save->SavedHeight = Canvas.Height;
+		Save->HasSavedFile = true;
+	}
+	else
+	{
+		AppState->PlatformFreeMemory(NewHashes);
+	}
+
+	return(Result);
+}
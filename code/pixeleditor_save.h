@@ -0,0 +1,24 @@
+#ifndef PIXEL_EDITOR_SAVE_H
+
+// NOTE(rick): Tracks what the working file on disk currently holds, as one
+// content hash per TILE_SIZE x TILE_SIZE canvas tile. A save only rewrites the
+// tiles whose hash no longer matches.
+struct save_state
+{
+	bool32 HasSavedFile;
+	uint32 SavedWidth;
+	uint32 SavedHeight;
+	int32 TilesX;
+	int32 TilesY;
+	uint64 *TileHashes;
+
+	uint32 LastSaveTileCount;
+	uint32 LastSaveBytesWritten;
+};
+
+// NOTE(rick): Past this fraction of changed tiles a plain full rewrite is
+// cheaper than seeking around the file.
+#define INCREMENTAL_SAVE_MAX_DIRTY_FRACTION 0.5f
+
+#define PIXEL_EDITOR_SAVE_H
+#endif
@@ -0,0 +1,240 @@
+// NOTE(rick): CellSize is known at compile time so the fill is fully unrolled
+// and the grid pixel lands at a fixed offset, no per-pixel edge test.
+template <int32 CellSize>
+static CELL_ROW_SCALER(ScaleCellRowFixed)
+{
+	Assert(Zoom == CellSize);
+	for(int32 Cell = 0; Cell < Count; ++Cell)
+	{
+		uint32 Color = Colors[Cell];
+		__m128i Fill = _mm_set1_epi32(Color);
+		int32 X = 0;
+		for(; X + 4 <= CellSize - 1; X += 4)
+		{
+			_mm_storeu_si128((__m128i *)(Dest + X), Fill);
+		}
+		for(; X < CellSize - 1; ++X)
+		{
+			Dest[X] = Color;
+		}
+		Dest[CellSize - 1] = GRID_LINE_COLOR;
+		Dest += CellSize;
+	}
+}
+
+static CELL_ROW_SCALER(ScaleCellRowAny)
+{
+	for(int32 Cell = 0; Cell < Count; ++Cell)
+	{
+		uint32 Color = Colors[Cell];
+		__m128i Fill = _mm_set1_epi32(Color);
+		int32 X = 0;
+		for(; X + 4 <= Zoom - 1; X += 4)
+		{
+			_mm_storeu_si128((__m128i *)(Dest + X), Fill);
+		}
+		for(; X < Zoom - 1; ++X)
+		{
+			Dest[X] = Color;
+		}
+		Dest[Zoom - 1] = GRID_LINE_COLOR;
+		Dest += Zoom;
+	}
+}
+
+// NOTE(rick): Mouse wheel zoom moves in steps of 5, so those get their own
+// kernel. Any other whole zoom uses the runtime sized one.
+static cell_row_scaler *
+ChooseCellRowScaler(int32 Zoom)
+{
+	cell_row_scaler *Result = ScaleCellRowAny;
+	switch(Zoom)
+	{
+		case 5: { Result = ScaleCellRowFixed<5>; } break;
+		case 10: { Result = ScaleCellRowFixed<10>; } break;
+		case 15: { Result = ScaleCellRowFixed<15>; } break;
+		case 20: { Result = ScaleCellRowFixed<20>; } break;
+		case 25: { Result = ScaleCellRowFixed<25>; } break;
+		case 30: { Result = ScaleCellRowFixed<30>; } break;
+		case 35: { Result = ScaleCellRowFixed<35>; } break;
+		case 40: { Result = ScaleCellRowFixed<40>; } break;
+		case 45: { Result = ScaleCellRowFixed<45>; } break;
+		case 50: { Result = ScaleCellRowFixed<50>; } break;
+		case 55: { Result = ScaleCellRowFixed<55>; } break;
+		case 60: { Result = ScaleCellRowFixed<60>; } break;
+		default: {} break;
+	}
+	return(Result);
+}
+
+// NOTE(rick): A cell cut off by the editing area keeps its grid line on the
+// last visible pixel, same as DrawRectangleWithBounds.
+static void
+FillClippedCellSpan(uint32 *Row, int32 MinX, int32 MaxX, uint32 Color)
+{
+	for(int32 X = MinX; X < MaxX - 1; ++X)
+	{
+		Row[X] = Color;
+	}
+	if(MaxX > MinX)
+	{
+		Row[MaxX - 1] = GRID_LINE_COLOR;
+	}
+}
+
+static void
+DrawPixelMapCellsGeneric(struct game_screen_buffer *Buffer, struct app_state *AppState,
+						 int32 MinCellX, int32 MinCellY, int32 MaxCellX, int32 MaxCellY)
+{
+	bool32 DrawOnionSkin = (AppState->Animation.OnionSkinEnabled && (AppState->Animation.FrameCount > 1));
+	for(int32 MapY = MinCellY; MapY < MaxCellY; ++MapY)
+	{
+		for(int32 MapX = MinCellX; MapX < MaxCellX; ++MapX)
+		{
+			v4 Color = AppState->PixelMap[(MapY * AppState->PixelMapWidth) + MapX];
+			if(DrawOnionSkin)
+			{
+				Color = ApplyOnionSkin(AppState, MapX, MapY, Color);
+			}
+			v2 Cell = PixelMapGridToScreen(AppState, MapX, MapY);
+			DrawRectangleWithBounds(Buffer,
+									AppState->EditingAreaOffset.x, AppState->EditingAreaOffset.x + AppState->EditingAreaSize.x,
+									AppState->EditingAreaOffset.y, AppState->EditingAreaOffset.y + AppState->EditingAreaSize.y,
+									Cell.x, Cell.y, AppState->PixelMapZoom, AppState->PixelMapZoom, Color);
+		}
+	}
+}
+
+// NOTE(rick): At a whole zoom every cell in view is the same size, so a row of
+// cells is expanded once into the screen by the kernel picked for this zoom,
+// copied down for the rest of the cell and finished with a grid row.
+// Fractional zooms fall back to drawing cell by cell.
+static void
+DrawPixelMap(struct game_screen_buffer *Buffer, struct app_state *AppState)
+{
+	int32 MinCellX = (int32)floorf(-AppState->EditingAreaMapOffset.x);
+	int32 MinCellY = (int32)floorf(-AppState->EditingAreaMapOffset.y);
+	int32 MaxCellX = (int32)ceilf(-AppState->EditingAreaMapOffset.x + (AppState->EditingAreaSize.x / AppState->PixelMapZoom));
+	int32 MaxCellY = (int32)ceilf(-AppState->EditingAreaMapOffset.y + (AppState->EditingAreaSize.y / AppState->PixelMapZoom));
+	int32 MapWidth = (int32)AppState->PixelMapWidth;
+	int32 MapHeight = (int32)AppState->PixelMapHeight;
+	if(MinCellX < 0) { MinCellX = 0; }
+	if(MinCellY < 0) { MinCellY = 0; }
+	if(MaxCellX > MapWidth) { MaxCellX = MapWidth; }
+	if(MaxCellY > MapHeight) { MaxCellY = MapHeight; }
+	if((MaxCellX <= MinCellX) || (MaxCellY <= MinCellY))
+	{
+		return;
+	}
+
+	int32 Zoom = (int32)AppState->PixelMapZoom;
+	if(((real32)Zoom != AppState->PixelMapZoom) || (Zoom < 2) ||
+	   ((MaxCellX - MinCellX) > MAX_SCALED_CELLS_PER_ROW))
+	{
+		DrawPixelMapCellsGeneric(Buffer, AppState, MinCellX, MinCellY, MaxCellX, MaxCellY);
+		return;
+	}
+	cell_row_scaler *ScaleCellRow = ChooseCellRowScaler(Zoom);
+
+	int32 BoundMinX = (int32)AppState->EditingAreaOffset.x;
+	int32 BoundMinY = (int32)AppState->EditingAreaOffset.y;
+	int32 BoundMaxX = (int32)(AppState->EditingAreaOffset.x + AppState->EditingAreaSize.x);
+	int32 BoundMaxY = (int32)(AppState->EditingAreaOffset.y + AppState->EditingAreaSize.y);
+	if(BoundMinX < 0) { BoundMinX = 0; }
+	if(BoundMinY < 0) { BoundMinY = 0; }
+	if(BoundMaxX > Buffer->Width) { BoundMaxX = Buffer->Width; }
+	if(BoundMaxY > Buffer->Height) { BoundMaxY = Buffer->Height; }
+
+	v2 FirstCell = PixelMapGridToScreen(AppState, MinCellX, MinCellY);
+	int32 CellX = (int32)floorf(FirstCell.x);
+	int32 CellY = (int32)floorf(FirstCell.y);
+
+	// NOTE(rick): Trim to the cells that really overlap the bounds now that
+	// the screen positions are whole pixels.
+	while((MinCellX < MaxCellX) && (CellX + Zoom <= BoundMinX))
+	{
+		++MinCellX;
+		CellX += Zoom;
+	}
+	while((MinCellY < MaxCellY) && (CellY + Zoom <= BoundMinY))
+	{
+		++MinCellY;
+		CellY += Zoom;
+	}
+	if((CellX >= BoundMaxX) || (CellY >= BoundMaxY))
+	{
+		return;
+	}
+	int32 VisibleX = (BoundMaxX - CellX + Zoom - 1) / Zoom;
+	int32 VisibleY = (BoundMaxY - CellY + Zoom - 1) / Zoom;
+	if(MaxCellX > MinCellX + VisibleX) { MaxCellX = MinCellX + VisibleX; }
+	if(MaxCellY > MinCellY + VisibleY) { MaxCellY = MinCellY + VisibleY; }
+
+	int32 Count = MaxCellX - MinCellX;
+	int32 SpanMinX = (CellX > BoundMinX) ? CellX : BoundMinX;
+	int32 SpanMaxX = CellX + (Count * Zoom);
+	if(SpanMaxX > BoundMaxX) { SpanMaxX = BoundMaxX; }
+
+	int32 FirstFull = (CellX < BoundMinX) ? 1 : 0;
+	int32 EndFull = ((CellX + (Count * Zoom)) > BoundMaxX) ? (Count - 1) : Count;
+
+	bool32 DrawOnionSkin = (AppState->Animation.OnionSkinEnabled && (AppState->Animation.FrameCount > 1));
+	uint32 Colors[MAX_SCALED_CELLS_PER_ROW];
+	uint8 *Base = (uint8 *)Buffer->BitmapMemory;
+	for(int32 MapY = MinCellY; MapY < MaxCellY; ++MapY, CellY += Zoom)
+	{
+		int32 MinY = (CellY > BoundMinY) ? CellY : BoundMinY;
+		int32 MaxY = ((CellY + Zoom) < BoundMaxY) ? (CellY + Zoom) : BoundMaxY;
+		if(MaxY <= MinY)
+		{
+			continue;
+		}
+
+		if(MaxY - 1 > MinY)
+		{
+			v4 *Pixels = AppState->PixelMap + (MapY * MapWidth) + MinCellX;
+			for(int32 Cell = 0; Cell < Count; ++Cell)
+			{
+				v4 Color = Pixels[Cell];
+				if(DrawOnionSkin)
+				{
+					Color = ApplyOnionSkin(AppState, MinCellX + Cell, MapY, Color);
+				}
+				Colors[Cell] = V4ToU32Pixel(Color);
+			}
+
+			uint32 *Row = (uint32 *)(Base + (MinY * Buffer->Pitch));
+			if(FirstFull > 0)
+			{
+				int32 CellMaxX = ((CellX + Zoom) < BoundMaxX) ? (CellX + Zoom) : BoundMaxX;
+				FillClippedCellSpan(Row, BoundMinX, CellMaxX, Colors[0]);
+			}
+			if(EndFull > FirstFull)
+			{
+				ScaleCellRow(Row + CellX + (FirstFull * Zoom), Colors + FirstFull, EndFull - FirstFull, Zoom);
+			}
+			if((EndFull < Count) && (EndFull >= FirstFull))
+			{
+				FillClippedCellSpan(Row, CellX + (EndFull * Zoom), BoundMaxX, Colors[EndFull]);
+			}
+
+			uint32 SpanBytes = (SpanMaxX - SpanMinX) * sizeof(uint32);
+			for(int32 Y = MinY + 1; Y < MaxY - 1; ++Y)
+			{
+				memcpy(Base + (Y * Buffer->Pitch) + (SpanMinX * sizeof(uint32)), Row + SpanMinX, SpanBytes);
+			}
+		}
+
+		uint32 *GridRow = (uint32 *)(Base + ((MaxY - 1) * Buffer->Pitch));
+		__m128i Grid = _mm_set1_epi32(GRID_LINE_COLOR);
+		int32 X = SpanMinX;
+		for(; X + 4 <= SpanMaxX; X += 4)
+		{
+			_mm_storeu_si128((__m128i *)(GridRow + X), Grid);
+		}
+		for(; X < SpanMaxX; ++X)
+		{
+			GridRow[X] = GRID_LINE_COLOR;
+		}
+	}
+}
@@ -0,0 +1,15 @@
+#ifndef PIXEL_EDITOR_SCALER_H
+
+#define GRID_LINE_COLOR 0xff666666
+
+// NOTE(rick): Only bounds the on-stack colour row; at the minimum zoom of 5
+// the editing area shows 140 cells across.
+#define MAX_SCALED_CELLS_PER_ROW 1024
+
+// NOTE(rick): Expands Count cell colours into one screen row. Every cell is
+// Zoom pixels wide and its last pixel is the grid line.
+#define CELL_ROW_SCALER(name) void name(uint32 *Dest, uint32 *Colors, int32 Count, int32 Zoom)
+typedef CELL_ROW_SCALER(cell_row_scaler);
+
+#define PIXEL_EDITOR_SCALER_H
+#endif
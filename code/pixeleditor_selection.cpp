@@ -0,0 +1,482 @@
+static inline struct pixel_buffer
+PixelMapBuffer(struct app_state *AppState)
+{
+	struct pixel_buffer Result = PixelBuffer(AppState->PixelMap, AppState->PixelMapWidth, AppState->PixelMapHeight);
+	return(Result);
+}
+
+// NOTE(rick): Drops any cells of the selection mask that fall outside the
+// canvas so a later lift never picks up pixels that do not exist.
+static void
+ClipSelectionToCanvas(struct app_state *AppState)
+{
+	struct selection_state *Selection = &AppState->Selection;
+	for(int32 Y = 0; Y < Selection->Mask.Height; ++Y)
+	{
+		int32 CanvasY = Selection->Y + Y;
+		if((CanvasY < 0) || (CanvasY >= (int32)AppState->PixelMapHeight))
+		{
+			WritePixelMaskSpan(&Selection->Mask, Y, 0, Selection->Mask.Width, false);
+		}
+		else
+		{
+			WritePixelMaskSpan(&Selection->Mask, Y, 0, -Selection->X, false);
+			WritePixelMaskSpan(&Selection->Mask, Y, AppState->PixelMapWidth - Selection->X, Selection->Mask.Width, false);
+		}
+	}
+}
+
+static void
+CommitFloatingSelection(struct app_state *AppState)
+{
+	struct selection_state *Selection = &AppState->Selection;
+	if(Selection->Floating)
+	{
+		struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+		BlitPixelBuffer(&Canvas, Selection->X, Selection->Y,
+						&Selection->FloatingPixels, 0, 0,
+						Selection->FloatingPixels.Width, Selection->FloatingPixels.Height,
+						BlitMode_Masked, V4(0.0f, 0.0f, 0.0f, 0.0f), &Selection->Mask);
+		FreePixelBuffer(AppState, &Selection->FloatingPixels);
+		ClipSelectionToCanvas(AppState);
+
+		Selection->Floating = false;
+		Selection->Moving = false;
+	}
+}
+
+static void
+DiscardSelection(struct app_state *AppState)
+{
+	struct selection_state *Selection = &AppState->Selection;
+	FreePixelBuffer(AppState, &Selection->FloatingPixels);
+	FreePixelMask(AppState, &Selection->Mask);
+	Selection->Active = false;
+	Selection->Selecting = false;
+	Selection->Floating = false;
+	Selection->Moving = false;
+}
+
+static void
+ClearSelection(struct app_state *AppState)
+{
+	CommitFloatingSelection(AppState);
+	DiscardSelection(AppState);
+}
+
+// NOTE(rick): Moves the selected pixels off the canvas and into the floating
+// buffer, leaving the canvas cleared underneath them.
+static void
+LiftSelection(struct app_state *AppState)
+{
+	struct selection_state *Selection = &AppState->Selection;
+	if(Selection->Active && !Selection->Floating)
+	{
+		if(AllocatePixelBuffer(AppState, &Selection->FloatingPixels, Selection->Mask.Width, Selection->Mask.Height))
+		{
+			struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+			BlitPixelBuffer(&Selection->FloatingPixels, 0, 0, &Canvas, Selection->X, Selection->Y,
+							Selection->Mask.Width, Selection->Mask.Height,
+							BlitMode_Copy, V4(0.0f, 0.0f, 0.0f, 0.0f), 0);
+			FillPixelBufferMasked(&Canvas, Selection->X, Selection->Y, &Selection->Mask, V4(0.0f, 0.0f, 0.0f, 0.0f));
+			Selection->Floating = true;
+		}
+	}
+}
+
+static void
+CopySelection(struct app_state *AppState)
+{
+	struct selection_state *Selection = &AppState->Selection;
+	if(!Selection->Active)
+	{
+		return;
+	}
+
+	if(AllocatePixelBuffer(AppState, &Selection->Clipboard, Selection->Mask.Width, Selection->Mask.Height) &&
+	   CopyPixelMask(AppState, &Selection->ClipboardMask, &Selection->Mask))
+	{
+		if(Selection->Floating)
+		{
+			BlitPixelBuffer(&Selection->Clipboard, 0, 0, &Selection->FloatingPixels, 0, 0,
+							Selection->Mask.Width, Selection->Mask.Height,
+							BlitMode_Copy, V4(0.0f, 0.0f, 0.0f, 0.0f), 0);
+		}
+		else
+		{
+			struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+			BlitPixelBuffer(&Selection->Clipboard, 0, 0, &Canvas, Selection->X, Selection->Y,
+							Selection->Mask.Width, Selection->Mask.Height,
+							BlitMode_Copy, V4(0.0f, 0.0f, 0.0f, 0.0f), 0);
+		}
+	}
+}
+
+static void
+DeleteSelection(struct app_state *AppState)
+{
+	struct selection_state *Selection = &AppState->Selection;
+	if(Selection->Active)
+	{
+		if(Selection->Floating)
+		{
+			FreePixelBuffer(AppState, &Selection->FloatingPixels);
+			Selection->Floating = false;
+			Selection->Moving = false;
+			ClipSelectionToCanvas(AppState);
+		}
+		else
+		{
+			struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+			FillPixelBufferMasked(&Canvas, Selection->X, Selection->Y, &Selection->Mask, V4(0.0f, 0.0f, 0.0f, 0.0f));
+		}
+	}
+}
+
+static void
+CutSelection(struct app_state *AppState)
+{
+	CopySelection(AppState);
+	DeleteSelection(AppState);
+}
+
+static void
+PasteSelection(struct app_state *AppState)
+{
+	struct selection_state *Selection = &AppState->Selection;
+	if(!Selection->Clipboard.Pixels)
+	{
+		return;
+	}
+
+	ClearSelection(AppState);
+
+	// NOTE(rick): Paste into the top-left corner of whatever part of the
+	// canvas is currently in view.
+	int32 X = (int32)-AppState->EditingAreaMapOffset.x;
+	int32 Y = (int32)-AppState->EditingAreaMapOffset.y;
+	if(X < 0) { X = 0; }
+	if(Y < 0) { Y = 0; }
+
+	if(AllocatePixelBuffer(AppState, &Selection->FloatingPixels, Selection->Clipboard.Width, Selection->Clipboard.Height) &&
+	   CopyPixelMask(AppState, &Selection->Mask, &Selection->ClipboardMask))
+	{
+		BlitPixelBuffer(&Selection->FloatingPixels, 0, 0, &Selection->Clipboard, 0, 0,
+						Selection->Clipboard.Width, Selection->Clipboard.Height,
+						BlitMode_Copy, V4(0.0f, 0.0f, 0.0f, 0.0f), 0);
+		Selection->Active = true;
+		Selection->Floating = true;
+		Selection->X = X;
+		Selection->Y = Y;
+		AppState->Tool = EditorTool_Move;
+	}
+}
+
+static void
+SelectRectangle(struct app_state *AppState, int32 MinX, int32 MinY, int32 MaxX, int32 MaxY)
+{
+	struct selection_state *Selection = &AppState->Selection;
+	if(AllocatePixelMask(AppState, &Selection->Mask, (MaxX - MinX) + 1, (MaxY - MinY) + 1))
+	{
+		for(int32 Y = 0; Y < Selection->Mask.Height; ++Y)
+		{
+			WritePixelMaskSpan(&Selection->Mask, Y, 0, Selection->Mask.Width, true);
+		}
+		Selection->Active = true;
+		Selection->X = MinX;
+		Selection->Y = MinY;
+	}
+}
+
+// NOTE(rick): Fills the lasso polygon using the even-odd rule sampled at cell
+// centers, then marks every cell the lasso passed through so thin strokes
+// still select something.
+static void
+SelectLasso(struct app_state *AppState)
+{
+	struct selection_state *Selection = &AppState->Selection;
+	int32 PointCount = Selection->LassoPointCount;
+	if(PointCount <= 0)
+	{
+		return;
+	}
+
+	int32 MinX = Selection->LassoX[0];
+	int32 MinY = Selection->LassoY[0];
+	int32 MaxX = MinX;
+	int32 MaxY = MinY;
+	for(int32 PointIndex = 1; PointIndex < PointCount; ++PointIndex)
+	{
+		if(Selection->LassoX[PointIndex] < MinX) { MinX = Selection->LassoX[PointIndex]; }
+		if(Selection->LassoY[PointIndex] < MinY) { MinY = Selection->LassoY[PointIndex]; }
+		if(Selection->LassoX[PointIndex] > MaxX) { MaxX = Selection->LassoX[PointIndex]; }
+		if(Selection->LassoY[PointIndex] > MaxY) { MaxY = Selection->LassoY[PointIndex]; }
+	}
+
+	if(!AllocatePixelMask(AppState, &Selection->Mask, (MaxX - MinX) + 1, (MaxY - MinY) + 1))
+	{
+		return;
+	}
+	Selection->Active = true;
+	Selection->X = MinX;
+	Selection->Y = MinY;
+
+	real32 Crossings[MAX_LASSO_POINTS];
+	for(int32 Y = 0; Y < Selection->Mask.Height; ++Y)
+	{
+		real32 SampleY = (real32)(MinY + Y);
+		int32 CrossingCount = 0;
+		for(int32 PointIndex = 0; PointIndex < PointCount; ++PointIndex)
+		{
+			int32 NextIndex = (PointIndex + 1) % PointCount;
+			real32 X0 = (real32)Selection->LassoX[PointIndex];
+			real32 Y0 = (real32)Selection->LassoY[PointIndex];
+			real32 X1 = (real32)Selection->LassoX[NextIndex];
+			real32 Y1 = (real32)Selection->LassoY[NextIndex];
+			if((Y0 > SampleY) != (Y1 > SampleY))
+			{
+				real32 CrossX = X0 + ((SampleY - Y0) * (X1 - X0)) / (Y1 - Y0);
+				int32 Insert = CrossingCount++;
+				while((Insert > 0) && (Crossings[Insert - 1] > CrossX))
+				{
+					Crossings[Insert] = Crossings[Insert - 1];
+					--Insert;
+				}
+				Crossings[Insert] = CrossX;
+			}
+		}
+
+		for(int32 CrossingIndex = 0; CrossingIndex + 1 < CrossingCount; CrossingIndex += 2)
+		{
+			int32 SpanMinX = (int32)ceilf(Crossings[CrossingIndex]) - MinX;
+			int32 SpanMaxX = (int32)floorf(Crossings[CrossingIndex + 1]) - MinX + 1;
+			WritePixelMaskSpan(&Selection->Mask, Y, SpanMinX, SpanMaxX, true);
+		}
+	}
+
+	for(int32 PointIndex = 0; PointIndex < PointCount; ++PointIndex)
+	{
+		int32 NextIndex = (PointIndex + 1) % PointCount;
+		int32 X0 = Selection->LassoX[PointIndex];
+		int32 Y0 = Selection->LassoY[PointIndex];
+		int32 X1 = Selection->LassoX[NextIndex];
+		int32 Y1 = Selection->LassoY[NextIndex];
+		int32 DeltaX = (X1 > X0) ? (X1 - X0) : (X0 - X1);
+		int32 DeltaY = (Y1 > Y0) ? (Y0 - Y1) : (Y1 - Y0);
+		int32 StepX = (X0 < X1) ? 1 : -1;
+		int32 StepY = (Y0 < Y1) ? 1 : -1;
+		int32 Error = DeltaX + DeltaY;
+		for(;;)
+		{
+			WritePixelMaskSpan(&Selection->Mask, Y0 - MinY, X0 - MinX, X0 - MinX + 1, true);
+			if((X0 == X1) && (Y0 == Y1))
+			{
+				break;
+			}
+
+			int32 Error2 = 2 * Error;
+			if(Error2 >= DeltaY) { Error += DeltaY; X0 += StepX; }
+			if(Error2 <= DeltaX) { Error += DeltaX; Y0 += StepY; }
+		}
+	}
+}
+
+static void
+UpdateSelectionTool(struct app_state *AppState, struct app_input *Input, bool32 PressedInEditingArea)
+{
+	struct selection_state *Selection = &AppState->Selection;
+
+	int32 GridX = 0;
+	int32 GridY = 0;
+	ScreenToPixelMapGrid(AppState, Input->MouseX, Input->MouseY, &GridX, &GridY);
+	int32 ClampedX = GridX;
+	int32 ClampedY = GridY;
+	if(ClampedX < 0) { ClampedX = 0; }
+	if(ClampedY < 0) { ClampedY = 0; }
+	if(ClampedX >= (int32)AppState->PixelMapWidth) { ClampedX = AppState->PixelMapWidth - 1; }
+	if(ClampedY >= (int32)AppState->PixelMapHeight) { ClampedY = AppState->PixelMapHeight - 1; }
+
+	switch(AppState->Tool)
+	{
+		case EditorTool_RectangleSelect:
+		{
+			if(PressedInEditingArea)
+			{
+				ClearSelection(AppState);
+				Selection->Selecting = true;
+				Selection->AnchorX = ClampedX;
+				Selection->AnchorY = ClampedY;
+			}
+			else if(Selection->Selecting && !Input->ButtonPrimary.EndedDown)
+			{
+				Selection->Selecting = false;
+				SelectRectangle(AppState,
+								(Selection->AnchorX < ClampedX) ? Selection->AnchorX : ClampedX,
+								(Selection->AnchorY < ClampedY) ? Selection->AnchorY : ClampedY,
+								(Selection->AnchorX > ClampedX) ? Selection->AnchorX : ClampedX,
+								(Selection->AnchorY > ClampedY) ? Selection->AnchorY : ClampedY);
+			}
+		} break;
+		case EditorTool_LassoSelect:
+		{
+			if(PressedInEditingArea)
+			{
+				ClearSelection(AppState);
+				Selection->Selecting = true;
+				Selection->LassoPointCount = 0;
+			}
+
+			if(Selection->Selecting)
+			{
+				int32 LastPoint = Selection->LassoPointCount - 1;
+				if((Selection->LassoPointCount < MAX_LASSO_POINTS) &&
+				   ((LastPoint < 0) ||
+					(Selection->LassoX[LastPoint] != ClampedX) ||
+					(Selection->LassoY[LastPoint] != ClampedY)))
+				{
+					Selection->LassoX[Selection->LassoPointCount] = ClampedX;
+					Selection->LassoY[Selection->LassoPointCount] = ClampedY;
+					++Selection->LassoPointCount;
+				}
+
+				if(!Input->ButtonPrimary.EndedDown)
+				{
+					Selection->Selecting = false;
+					SelectLasso(AppState);
+				}
+			}
+		} break;
+		case EditorTool_Move:
+		{
+			if(PressedInEditingArea && Selection->Active &&
+			   IsPixelMaskSet(&Selection->Mask, GridX - Selection->X, GridY - Selection->Y))
+			{
+				LiftSelection(AppState);
+				Selection->Moving = Selection->Floating;
+				Selection->GrabX = GridX - Selection->X;
+				Selection->GrabY = GridY - Selection->Y;
+			}
+
+			if(Selection->Moving)
+			{
+				Selection->X = GridX - Selection->GrabX;
+				Selection->Y = GridY - Selection->GrabY;
+				if(!Input->ButtonPrimary.EndedDown)
+				{
+					Selection->Moving = false;
+				}
+			}
+		} break;
+		default: {} break;
+	}
+}
+
+static void
+DrawRectangleInEditingArea(struct game_screen_buffer *Buffer, struct app_state *AppState,
+						   real32 X, real32 Y, real32 Width, real32 Height, union v4 Color)
+{
+	real32 MinX = X;
+	real32 MinY = Y;
+	real32 MaxX = X + Width;
+	real32 MaxY = Y + Height;
+	if(MinX < AppState->EditingAreaOffset.x) { MinX = AppState->EditingAreaOffset.x; }
+	if(MinY < AppState->EditingAreaOffset.y) { MinY = AppState->EditingAreaOffset.y; }
+	if(MaxX > AppState->EditingAreaOffset.x + AppState->EditingAreaSize.x) { MaxX = AppState->EditingAreaOffset.x + AppState->EditingAreaSize.x; }
+	if(MaxY > AppState->EditingAreaOffset.y + AppState->EditingAreaSize.y) { MaxY = AppState->EditingAreaOffset.y + AppState->EditingAreaSize.y; }
+
+	if((MaxX > MinX) && (MaxY > MinY))
+	{
+		DrawRectangle(Buffer, MinX, MinY, MaxX - MinX, MaxY - MinY, Color);
+	}
+}
+
+static void
+DrawSelectionOutline(struct game_screen_buffer *Buffer, struct app_state *AppState,
+					 int32 MinX, int32 MinY, int32 Width, int32 Height)
+{
+	v2 Min = PixelMapGridToScreen(AppState, MinX, MinY);
+	v2 Max = PixelMapGridToScreen(AppState, MinX + Width, MinY + Height);
+	v2 Size = V2(Max.x - Min.x, Max.y - Min.y);
+
+	v4 Light = V4(0xff, 0xff, 0xff, 0xff);
+	v4 Dark = V4(0x00, 0x00, 0x00, 0xff);
+	DrawRectangleInEditingArea(Buffer, AppState, Min.x - 1, Min.y - 1, Size.x + 2, 2, Dark);
+	DrawRectangleInEditingArea(Buffer, AppState, Min.x - 1, Max.y - 1, Size.x + 2, 2, Dark);
+	DrawRectangleInEditingArea(Buffer, AppState, Min.x - 1, Min.y - 1, 2, Size.y + 2, Dark);
+	DrawRectangleInEditingArea(Buffer, AppState, Max.x - 1, Min.y - 1, 2, Size.y + 2, Dark);
+	DrawRectangleInEditingArea(Buffer, AppState, Min.x, Min.y, Size.x, 1, Light);
+	DrawRectangleInEditingArea(Buffer, AppState, Min.x, Max.y - 1, Size.x, 1, Light);
+	DrawRectangleInEditingArea(Buffer, AppState, Min.x, Min.y, 1, Size.y, Light);
+	DrawRectangleInEditingArea(Buffer, AppState, Max.x - 1, Min.y, 1, Size.y, Light);
+}
+
+static void
+DrawSelection(struct game_screen_buffer *Buffer, struct app_state *AppState, struct app_input *Input)
+{
+	struct selection_state *Selection = &AppState->Selection;
+
+	if(Selection->Floating)
+	{
+		// NOTE(rick): Only walk the cells that are actually in view, a large
+		// floating selection is mostly off screen at high zoom.
+		int32 ViewMinX = (int32)floorf(-AppState->EditingAreaMapOffset.x);
+		int32 ViewMinY = (int32)floorf(-AppState->EditingAreaMapOffset.y);
+		int32 ViewMaxX = (int32)ceilf(-AppState->EditingAreaMapOffset.x + (AppState->EditingAreaSize.x / AppState->PixelMapZoom));
+		int32 ViewMaxY = (int32)ceilf(-AppState->EditingAreaMapOffset.y + (AppState->EditingAreaSize.y / AppState->PixelMapZoom));
+
+		int32 MinX = (ViewMinX > Selection->X) ? (ViewMinX - Selection->X) : 0;
+		int32 MinY = (ViewMinY > Selection->Y) ? (ViewMinY - Selection->Y) : 0;
+		int32 MaxX = ViewMaxX - Selection->X;
+		int32 MaxY = ViewMaxY - Selection->Y;
+		if(MaxX > Selection->FloatingPixels.Width) { MaxX = Selection->FloatingPixels.Width; }
+		if(MaxY > Selection->FloatingPixels.Height) { MaxY = Selection->FloatingPixels.Height; }
+
+		for(int32 Y = MinY; Y < MaxY; ++Y)
+		{
+			v4 *Row = PixelBufferRow(&Selection->FloatingPixels, Y);
+			for(int32 X = MinX; X < MaxX; ++X)
+			{
+				if(IsPixelMaskSet(&Selection->Mask, X, Y))
+				{
+					v2 Cell = PixelMapGridToScreen(AppState, Selection->X + X, Selection->Y + Y);
+					DrawRectangleWithBounds(Buffer,
+											AppState->EditingAreaOffset.x, AppState->EditingAreaOffset.x + AppState->EditingAreaSize.x,
+											AppState->EditingAreaOffset.y, AppState->EditingAreaOffset.y + AppState->EditingAreaSize.y,
+											Cell.x, Cell.y, AppState->PixelMapZoom, AppState->PixelMapZoom, Row[X]);
+				}
+			}
+		}
+	}
+
+	if(Selection->Selecting)
+	{
+		if(AppState->Tool == EditorTool_RectangleSelect)
+		{
+			int32 GridX = 0;
+			int32 GridY = 0;
+			ScreenToPixelMapGrid(AppState, Input->MouseX, Input->MouseY, &GridX, &GridY);
+			if(GridX < 0) { GridX = 0; }
+			if(GridY < 0) { GridY = 0; }
+			if(GridX >= (int32)AppState->PixelMapWidth) { GridX = AppState->PixelMapWidth - 1; }
+			if(GridY >= (int32)AppState->PixelMapHeight) { GridY = AppState->PixelMapHeight - 1; }
+
+			int32 MinX = (Selection->AnchorX < GridX) ? Selection->AnchorX : GridX;
+			int32 MinY = (Selection->AnchorY < GridY) ? Selection->AnchorY : GridY;
+			int32 MaxX = (Selection->AnchorX > GridX) ? Selection->AnchorX : GridX;
+			int32 MaxY = (Selection->AnchorY > GridY) ? Selection->AnchorY : GridY;
+			DrawSelectionOutline(Buffer, AppState, MinX, MinY, (MaxX - MinX) + 1, (MaxY - MinY) + 1);
+		}
+		else if(AppState->Tool == EditorTool_LassoSelect)
+		{
+			for(int32 PointIndex = 0; PointIndex < Selection->LassoPointCount; ++PointIndex)
+			{
+				v2 Cell = PixelMapGridToScreen(AppState, Selection->LassoX[PointIndex] + 0.5f, Selection->LassoY[PointIndex] + 0.5f);
+				DrawRectangleInEditingArea(Buffer, AppState, Cell.x - 1, Cell.y - 1, 3, 3, V4(0xff, 0xff, 0xff, 0xff));
+			}
+		}
+	}
+	else if(Selection->Active)
+	{
+		DrawSelectionOutline(Buffer, AppState, Selection->X, Selection->Y, Selection->Mask.Width, Selection->Mask.Height);
+	}
+}
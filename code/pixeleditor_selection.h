@@ -0,0 +1,35 @@
+#ifndef PIXEL_EDITOR_SELECTION_H
+
+#define MAX_LASSO_POINTS 2048
+
+struct selection_state
+{
+	// NOTE(rick): Mask is placed on the canvas with its top-left at (X, Y) and
+	// may hang off the edges while it is being moved.
+	bool32 Active;
+	int32 X;
+	int32 Y;
+	struct pixel_mask Mask;
+
+	bool32 Selecting;
+	int32 AnchorX;
+	int32 AnchorY;
+	int32 LassoPointCount;
+	int32 LassoX[MAX_LASSO_POINTS];
+	int32 LassoY[MAX_LASSO_POINTS];
+
+	// NOTE(rick): While floating, the selected pixels live in FloatingPixels
+	// and are only drawn over the canvas. They are stamped back into the
+	// PixelMap when the selection is committed.
+	bool32 Floating;
+	struct pixel_buffer FloatingPixels;
+	bool32 Moving;
+	int32 GrabX;
+	int32 GrabY;
+
+	struct pixel_buffer Clipboard;
+	struct pixel_mask ClipboardMask;
+};
+
+#define PIXEL_EDITOR_SELECTION_H
+#endif
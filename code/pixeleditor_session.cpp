@@ -0,0 +1,155 @@
+static uint32
+SessionCanvasOffset(void)
+{
+	uint32 Result = (sizeof(struct session_snapshot) + 15) & ~15;
+	return(Result);
+}
+
+// NOTE(rick): Writes the canvas and the view and palette settings around it
+// as one session_snapshot block. Only the current frame's canvas is kept.
+static bool32
+WriteSessionSnapshot(struct app_state *AppState, char *Filename)
+{
+	CommitFloatingSelection(AppState);
+
+	struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+	uint32 CanvasOffset = SessionCanvasOffset();
+	uint64 Size = CanvasOffset + ((uint64)Canvas.Width * Canvas.Height * sizeof(v4));
+	// NOTE(rick): Never write a snapshot SessionSnapshotIsValid would turn away.
+	if(!Canvas.Pixels ||
+	   (Canvas.Width > MAX_CANVAS_DIMENSION) || (Canvas.Height > MAX_CANVAS_DIMENSION) ||
+	   (Size > 0xFFFFFFFF))
+	{
+		return(false);
+	}
+
+	uint8 *Block = (uint8 *)AppState->PlatformAllocateMemory((uint32)Size);
+	if(!Block)
+	{
+		return(false);
+	}
+
+	struct session_snapshot *Snapshot = (struct session_snapshot *)Block;
+	Snapshot->Magic = SESSION_MAGIC;
+	Snapshot->Version = SESSION_VERSION;
+	Snapshot->Size = (uint32)Size;
+	Snapshot->CanvasWidth = Canvas.Width;
+	Snapshot->CanvasHeight = Canvas.Height;
+	Snapshot->CanvasOffset = CanvasOffset;
+	Snapshot->PixelMapZoom = AppState->PixelMapZoom;
+	Snapshot->EditingAreaMapOffset = AppState->EditingAreaMapOffset;
+	Snapshot->PixelColor = AppState->PixelColor;
+	Snapshot->QuickSwitchColor = AppState->QuickSwitchColor.Color;
+	for(int32 Index = 0; Index < MAX_CUSTOM_COLORS; ++Index)
+	{
+		Snapshot->CustomColors[Index] = AppState->CustomColorButtons[Index].Color;
+	}
+	Snapshot->Tool = AppState->Tool;
+	Snapshot->ShapeFilled = AppState->Shape.Filled;
+	Snapshot->GradientKind = AppState->Gradient.Kind;
+	Snapshot->GradientDither = AppState->Gradient.Dither;
+	Snapshot->GradientSteps = AppState->Gradient.Steps;
+	Snapshot->RecolorTolerance = AppState->RecolorTolerance;
+
+	v4 *Pixels = (v4 *)(Block + CanvasOffset);
+	for(int32 Y = 0; Y < Canvas.Height; ++Y)
+	{
+		BlitRowCopy(Pixels + (Y * Canvas.Width), PixelBufferRow(&Canvas, Y), Canvas.Width, false);
+	}
+
+	bool32 Result = AppState->PlatformWriteFile(Filename, Block, (uint32)Size);
+	AppState->PlatformFreeMemory(Block);
+	return(Result);
+}
+
+static bool32
+SessionSnapshotIsValid(struct session_snapshot *Snapshot, uint32 FileSize)
+{
+	bool32 Result = false;
+	if((FileSize >= sizeof(struct session_snapshot)) &&
+	   (Snapshot->Magic == SESSION_MAGIC) &&
+	   (Snapshot->Version == SESSION_VERSION) &&
+	   (Snapshot->Size == FileSize) &&
+	   (Snapshot->CanvasWidth > 0) && (Snapshot->CanvasWidth <= MAX_CANVAS_DIMENSION) &&
+	   (Snapshot->CanvasHeight > 0) && (Snapshot->CanvasHeight <= MAX_CANVAS_DIMENSION) &&
+	   (Snapshot->CanvasOffset >= sizeof(struct session_snapshot)) &&
+	   ((Snapshot->CanvasOffset % 16) == 0) &&
+	   (((uint64)Snapshot->CanvasOffset + ((uint64)Snapshot->CanvasWidth * Snapshot->CanvasHeight * sizeof(v4))) <= FileSize))
+	{
+		Result = true;
+	}
+	return(Result);
+}
+
+// NOTE(rick): Runs once at the end of initialization. The snapshot is mapped
+// rather than read and parsed, so restoring costs the canvas-sized copy
+// ResizeCanvas would have cleared anyway plus a few field assignments.
+static bool32
+RestoreSessionSnapshot(struct app_state *AppState, char *Filename)
+{
+	if(!AppState->PlatformMapFile)
+	{
+		return(false);
+	}
+
+	struct platform_file_contents File = AppState->PlatformMapFile(Filename);
+	if(!File.Data)
+	{
+		return(false);
+	}
+
+	struct session_snapshot *Snapshot = (struct session_snapshot *)File.Data;
+	bool32 Result = SessionSnapshotIsValid(Snapshot, File.Size);
+	if(Result)
+	{
+		if((Snapshot->CanvasWidth != AppState->PixelMapWidth) ||
+		   (Snapshot->CanvasHeight != AppState->PixelMapHeight))
+		{
+			ResizeCanvas(AppState, Snapshot->CanvasWidth, Snapshot->CanvasHeight);
+		}
+
+		struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+		v4 *Pixels = (v4 *)((uint8 *)File.Data + Snapshot->CanvasOffset);
+		for(int32 Y = 0; Y < Canvas.Height; ++Y)
+		{
+			BlitRowCopy(PixelBufferRow(&Canvas, Y), Pixels + (Y * Canvas.Width), Canvas.Width, false);
+		}
+		SyncCurrentFrame(AppState);
+
+		if(Snapshot->PixelMapZoom >= AppState->MinPixelMapZoom)
+		{
+			AppState->PixelMapZoom = Snapshot->PixelMapZoom;
+		}
+		AppState->EditingAreaMapOffset = Snapshot->EditingAreaMapOffset;
+		UpdatePixelEditorPosition(AppState, NULL);
+
+		AppState->PixelColor = Snapshot->PixelColor;
+		AppState->QuickSwitchColor.Color = Snapshot->QuickSwitchColor;
+		for(int32 Index = 0; Index < MAX_CUSTOM_COLORS; ++Index)
+		{
+			AppState->CustomColorButtons[Index].Color = Snapshot->CustomColors[Index];
+		}
+
+		if((Snapshot->Tool >= EditorTool_Pencil) && (Snapshot->Tool <= EditorTool_Gradient))
+		{
+			AppState->Tool = (enum editor_tool)Snapshot->Tool;
+		}
+		AppState->Shape.Filled = Snapshot->ShapeFilled;
+		if((Snapshot->GradientKind == GradientKind_Linear) || (Snapshot->GradientKind == GradientKind_Radial))
+		{
+			AppState->Gradient.Kind = (enum gradient_kind)Snapshot->GradientKind;
+		}
+		if((Snapshot->GradientDither == GradientDither_Bayer) || (Snapshot->GradientDither == GradientDither_None))
+		{
+			AppState->Gradient.Dither = (enum gradient_dither)Snapshot->GradientDither;
+		}
+		if((Snapshot->GradientSteps >= MIN_GRADIENT_STEPS) && (Snapshot->GradientSteps <= MAX_GRADIENT_STEPS))
+		{
+			AppState->Gradient.Steps = Snapshot->GradientSteps;
+		}
+		AppState->RecolorTolerance = Snapshot->RecolorTolerance;
+	}
+
+	AppState->PlatformUnmapFile(File.Data, File.Size);
+	return(Result);
+}
@@ -0,0 +1,37 @@
+#ifndef PIXEL_EDITOR_SESSION_H
+
+#define SESSION_FILENAME "PixelEditor.session"
+#define SESSION_MAGIC 0x53455850 // NOTE(rick): "PXES"
+#define SESSION_VERSION 1
+
+// NOTE(rick): The whole snapshot is one flat block, written to disk as is and
+// mapped straight back in. It holds no pointers, the canvas is found at
+// CanvasOffset bytes from the start of the block, so the block means the same
+// thing wherever it ends up in memory.
+struct session_snapshot
+{
+	uint32 Magic;
+	uint32 Version;
+	uint32 Size;
+
+	uint32 CanvasWidth;
+	uint32 CanvasHeight;
+	uint32 CanvasOffset;
+
+	real32 PixelMapZoom;
+	v2 EditingAreaMapOffset;
+
+	v4 PixelColor;
+	v4 QuickSwitchColor;
+	v4 CustomColors[MAX_CUSTOM_COLORS];
+
+	int32 Tool;
+	bool32 ShapeFilled;
+	int32 GradientKind;
+	int32 GradientDither;
+	int32 GradientSteps;
+	real32 RecolorTolerance;
+};
+
+#define PIXEL_EDITOR_SESSION_H
+#endif
@@ -0,0 +1,356 @@
+static inline void
+EmitShapeSpan(shape_span_callback *Callback, void *Context, int32 Y, int32 A, int32 B)
+{
+	if(A <= B)
+	{
+		Callback(Context, Y, A, B);
+	}
+	else
+	{
+		Callback(Context, Y, B, A);
+	}
+}
+
+// NOTE(rick): Bresenham, with consecutive cells on the same row merged into a
+// single span.
+static void
+RasterizeLine(int32 X0, int32 Y0, int32 X1, int32 Y1, shape_span_callback *Callback, void *Context)
+{
+	int32 DeltaX = (X1 > X0) ? (X1 - X0) : (X0 - X1);
+	int32 DeltaY = (Y1 > Y0) ? (Y0 - Y1) : (Y1 - Y0);
+	int32 StepX = (X0 < X1) ? 1 : -1;
+	int32 StepY = (Y0 < Y1) ? 1 : -1;
+	int32 Error = DeltaX + DeltaY;
+
+	int32 RunStartX = X0;
+	for(;;)
+	{
+		if((X0 == X1) && (Y0 == Y1))
+		{
+			EmitShapeSpan(Callback, Context, Y0, RunStartX, X0);
+			break;
+		}
+
+		int32 OldX = X0;
+		int32 OldY = Y0;
+		int32 Error2 = 2 * Error;
+		if(Error2 >= DeltaY) { Error += DeltaY; X0 += StepX; }
+		if(Error2 <= DeltaX) { Error += DeltaX; Y0 += StepY; }
+
+		if(Y0 != OldY)
+		{
+			EmitShapeSpan(Callback, Context, OldY, RunStartX, OldX);
+			RunStartX = X0;
+		}
+	}
+}
+
+static void
+RasterizeRectangle(int32 X0, int32 Y0, int32 X1, int32 Y1, bool32 Filled,
+				   shape_span_callback *Callback, void *Context)
+{
+	int32 MinX = (X0 < X1) ? X0 : X1;
+	int32 MaxX = (X0 < X1) ? X1 : X0;
+	int32 MinY = (Y0 < Y1) ? Y0 : Y1;
+	int32 MaxY = (Y0 < Y1) ? Y1 : Y0;
+
+	for(int32 Y = MinY; Y <= MaxY; ++Y)
+	{
+		if(Filled || (Y == MinY) || (Y == MaxY))
+		{
+			Callback(Context, Y, MinX, MaxX);
+		}
+		else
+		{
+			Callback(Context, Y, MinX, MinX);
+			if(MaxX != MinX)
+			{
+				Callback(Context, Y, MaxX, MaxX);
+			}
+		}
+	}
+}
+
+struct ellipse_row
+{
+	int32 Y;
+	int32 OuterLeft;
+	int32 InnerLeft;
+	int32 InnerRight;
+	int32 OuterRight;
+};
+
+static void
+EmitEllipseRow(struct ellipse_row *Row, bool32 Filled, shape_span_callback *Callback, void *Context)
+{
+	if(Filled || (Row->InnerLeft + 1 >= Row->InnerRight))
+	{
+		Callback(Context, Row->Y, Row->OuterLeft, Row->OuterRight);
+	}
+	else
+	{
+		Callback(Context, Row->Y, Row->OuterLeft, Row->InnerLeft);
+		Callback(Context, Row->Y, Row->InnerRight, Row->OuterRight);
+	}
+}
+
+// NOTE(rick): Integer midpoint ellipse fitted to the bounding box, after Alois
+// Zingl's "A Rasterizing Algorithm for Drawing Curves". It starts at the
+// widest rows in the middle and walks out towards the top and bottom, so the
+// first cell visited on a row is its outermost one. A row is emitted as soon as
+// the walk steps off it.
+static void
+RasterizeEllipse(int32 X0, int32 Y0, int32 X1, int32 Y1, bool32 Filled,
+				 shape_span_callback *Callback, void *Context)
+{
+	if(X0 > X1) { int32 Temp = X0; X0 = X1; X1 = Temp; }
+	if(Y0 > Y1) { int32 Temp = Y0; Y0 = Y1; Y1 = Temp; }
+
+	int64 A = X1 - X0;
+	int64 B = Y1 - Y0;
+	int64 B1 = B & 1;
+	int64 DeltaX = 4 * (1 - A) * B * B;
+	int64 DeltaY = 4 * (B1 + 1) * A * A;
+	int64 Error = DeltaX + DeltaY + (B1 * A * A);
+
+	Y0 += (int32)((B + 1) / 2);
+	Y1 = Y0 - (int32)B1;
+	A *= 8 * A;
+	B1 = 8 * B * B;
+
+	struct ellipse_row Lower = {Y0, X0, X0, X1, X1};
+	struct ellipse_row Upper = {Y1, X0, X0, X1, X1};
+	bool32 RowPending = false;
+	do
+	{
+		Lower.InnerLeft = Upper.InnerLeft = X0;
+		Lower.InnerRight = Upper.InnerRight = X1;
+		RowPending = true;
+
+		int64 Error2 = 2 * Error;
+		bool32 SteppedY = false;
+		if(Error2 <= DeltaY)
+		{
+			++Y0;
+			--Y1;
+			DeltaY += A;
+			Error += DeltaY;
+			SteppedY = true;
+		}
+		if((Error2 >= DeltaX) || ((2 * Error) > DeltaY))
+		{
+			++X0;
+			--X1;
+			DeltaX += B1;
+			Error += DeltaX;
+		}
+
+		if(SteppedY)
+		{
+			EmitEllipseRow(&Lower, Filled, Callback, Context);
+			if(Upper.Y != Lower.Y)
+			{
+				EmitEllipseRow(&Upper, Filled, Callback, Context);
+			}
+			RowPending = false;
+
+			Lower.Y = Y0;
+			Upper.Y = Y1;
+			Lower.OuterLeft = Upper.OuterLeft = X0;
+			Lower.OuterRight = Upper.OuterRight = X1;
+		}
+	} while(X0 <= X1);
+
+	// NOTE(rick): From here Y0 and Y1 are the next rows below and above the
+	// ones already emitted. When the last step was along Y they are still
+	// pending, the walk never visited them.
+	if(RowPending)
+	{
+		EmitEllipseRow(&Lower, Filled, Callback, Context);
+		if(Upper.Y != Lower.Y)
+		{
+			EmitEllipseRow(&Upper, Filled, Callback, Context);
+		}
+		++Y0;
+		--Y1;
+	}
+
+	// NOTE(rick): Tall, narrow ellipses run out of columns before rows, finish
+	// off their tips.
+	while((Y0 - Y1) <= B)
+	{
+		Callback(Context, Y0++, X0 - 1, X1 + 1);
+		Callback(Context, Y1--, X0 - 1, X1 + 1);
+	}
+
+	// NOTE(rick): Every row of the bounding box has had a span.
+	Assert((Y0 - Y1 - 1) == (B + 1));
+}
+
+static void
+RasterizeShape(enum shape_kind Kind, bool32 Filled, int32 X0, int32 Y0, int32 X1, int32 Y1,
+			   shape_span_callback *Callback, void *Context)
+{
+	switch(Kind)
+	{
+		case ShapeKind_Line:
+		{
+			RasterizeLine(X0, Y0, X1, Y1, Callback, Context);
+		} break;
+		case ShapeKind_Rectangle:
+		{
+			RasterizeRectangle(X0, Y0, X1, Y1, Filled, Callback, Context);
+		} break;
+		case ShapeKind_Ellipse:
+		{
+			RasterizeEllipse(X0, Y0, X1, Y1, Filled, Callback, Context);
+		} break;
+	}
+}
+
+struct canvas_span_context
+{
+	struct pixel_buffer Canvas;
+	__m128 Color;
+	bool32 Wrap;
+};
+
+static void
+FillCanvasRowSpan(struct canvas_span_context *SpanContext, int32 Y, int32 MinX, int32 MaxX)
+{
+	v4 *Row = PixelBufferRow(&SpanContext->Canvas, Y);
+	for(int32 X = MinX; X <= MaxX; ++X)
+	{
+		_mm_storeu_ps(Row[X].E, SpanContext->Color);
+	}
+}
+
+// NOTE(rick): In wrap mode spans come in unbounded cell coordinates and are
+// folded back onto the canvas, split in two where they cross its right edge.
+static SHAPE_SPAN_CALLBACK(FillCanvasSpan)
+{
+	struct canvas_span_context *SpanContext = (struct canvas_span_context *)Context;
+	struct pixel_buffer *Canvas = &SpanContext->Canvas;
+	if(SpanContext->Wrap)
+	{
+		Y = WrapCoordinate(Y, Canvas->Height);
+		if((MaxX - MinX + 1) >= Canvas->Width)
+		{
+			FillCanvasRowSpan(SpanContext, Y, 0, Canvas->Width - 1);
+		}
+		else
+		{
+			int32 Length = MaxX - MinX;
+			MinX = WrapCoordinate(MinX, Canvas->Width);
+			MaxX = MinX + Length;
+			if(MaxX >= Canvas->Width)
+			{
+				FillCanvasRowSpan(SpanContext, Y, 0, MaxX - Canvas->Width);
+				MaxX = Canvas->Width - 1;
+			}
+			FillCanvasRowSpan(SpanContext, Y, MinX, MaxX);
+		}
+		return;
+	}
+
+	if((Y < 0) || (Y >= Canvas->Height))
+	{
+		return;
+	}
+	if(MinX < 0) { MinX = 0; }
+	if(MaxX >= Canvas->Width) { MaxX = Canvas->Width - 1; }
+
+	FillCanvasRowSpan(SpanContext, Y, MinX, MaxX);
+}
+
+struct preview_span_context
+{
+	struct game_screen_buffer *Buffer;
+	struct app_state *AppState;
+	v4 Color;
+};
+
+// NOTE(rick): The preview draws each span as one solid rectangle in screen
+// space, so its cost follows the number of rows rather than the number of
+// cells covered.
+static SHAPE_SPAN_CALLBACK(DrawPreviewSpan)
+{
+	struct preview_span_context *SpanContext = (struct preview_span_context *)Context;
+	struct app_state *AppState = SpanContext->AppState;
+	v2 Min = PixelMapGridToScreen(AppState, MinX, Y);
+	v2 Max = PixelMapGridToScreen(AppState, MaxX + 1, Y + 1);
+	DrawRectangleInEditingArea(SpanContext->Buffer, AppState, Min.x, Min.y,
+							   Max.x - Min.x, Max.y - Min.y, SpanContext->Color);
+}
+
+inline static bool32
+IsShapeTool(enum editor_tool Tool)
+{
+	bool32 Result = ((Tool == EditorTool_Line) ||
+					 (Tool == EditorTool_Rectangle) ||
+					 (Tool == EditorTool_Ellipse));
+	return(Result);
+}
+
+inline static enum shape_kind
+ShapeKindForTool(enum editor_tool Tool)
+{
+	enum shape_kind Result = ShapeKind_Line;
+	if(Tool == EditorTool_Rectangle) { Result = ShapeKind_Rectangle; }
+	if(Tool == EditorTool_Ellipse) { Result = ShapeKind_Ellipse; }
+	return(Result);
+}
+
+// NOTE(rick): Nothing touches the canvas until the button is released; while
+// dragging only the end point is tracked and DrawShapePreview overlays it.
+static void
+UpdateShapeTool(struct app_state *AppState, struct app_input *Input, bool32 PressedInEditingArea)
+{
+	struct shape_state *Shape = &AppState->Shape;
+
+	int32 GridX = 0;
+	int32 GridY = 0;
+	ScreenToPixelMapGrid(AppState, Input->MouseX, Input->MouseY, &GridX, &GridY);
+
+	if(PressedInEditingArea)
+	{
+		Shape->Dragging = true;
+		Shape->StartX = GridX;
+		Shape->StartY = GridY;
+	}
+
+	if(Shape->Dragging)
+	{
+		Shape->EndX = GridX;
+		Shape->EndY = GridY;
+
+		if(!Input->ButtonPrimary.EndedDown)
+		{
+			struct canvas_span_context Context = {0};
+			Context.Canvas = PixelMapBuffer(AppState);
+			Context.Wrap = AppState->Wrap.Enabled;
+			Context.Color = _mm_setr_ps(AppState->PixelColor.E[0], AppState->PixelColor.E[1],
+										AppState->PixelColor.E[2], AppState->PixelColor.E[3]);
+			RasterizeShape(ShapeKindForTool(AppState->Tool), Shape->Filled,
+						   Shape->StartX, Shape->StartY, Shape->EndX, Shape->EndY,
+						   FillCanvasSpan, &Context);
+			Shape->Dragging = false;
+		}
+	}
+}
+
+static void
+DrawShapePreview(struct game_screen_buffer *Buffer, struct app_state *AppState)
+{
+	struct shape_state *Shape = &AppState->Shape;
+	if(Shape->Dragging && IsShapeTool(AppState->Tool))
+	{
+		struct preview_span_context Context = {0};
+		Context.Buffer = Buffer;
+		Context.AppState = AppState;
+		Context.Color = AppState->PixelColor;
+		RasterizeShape(ShapeKindForTool(AppState->Tool), Shape->Filled,
+					   Shape->StartX, Shape->StartY, Shape->EndX, Shape->EndY,
+					   DrawPreviewSpan, &Context);
+	}
+}
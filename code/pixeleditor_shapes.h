@@ -0,0 +1,27 @@
+#ifndef PIXEL_EDITOR_SHAPES_H
+
+enum shape_kind
+{
+	ShapeKind_Line,
+	ShapeKind_Rectangle,
+	ShapeKind_Ellipse,
+};
+
+// NOTE(rick): Shapes are rasterized as inclusive horizontal spans in canvas
+// cell coordinates. The same rasterizer feeds both the live preview and the
+// final write into the PixelMap.
+#define SHAPE_SPAN_CALLBACK(name) void name(void *Context, int32 Y, int32 MinX, int32 MaxX)
+typedef SHAPE_SPAN_CALLBACK(shape_span_callback);
+
+struct shape_state
+{
+	bool32 Dragging;
+	bool32 Filled;
+	int32 StartX;
+	int32 StartY;
+	int32 EndX;
+	int32 EndY;
+};
+
+#define PIXEL_EDITOR_SHAPES_H
+#endif
@@ -0,0 +1,313 @@
+static uint8 GlobalFontGlyphs[FONT_GLYPH_COUNT][FONT_GLYPH_HEIGHT] =
+{
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+	{0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}, // '!'
+	{0x0a, 0x0a, 0x0a, 0x00, 0x00, 0x00, 0x00}, // '"'
+	{0x0a, 0x0a, 0x1f, 0x0a, 0x1f, 0x0a, 0x0a}, // '#'
+	{0x04, 0x0f, 0x14, 0x0e, 0x05, 0x1e, 0x04}, // '$'
+	{0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, // '%'
+	{0x0c, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0d}, // '&'
+	{0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00}, // apostrophe
+	{0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}, // '('
+	{0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}, // ')'
+	{0x00, 0x04, 0x15, 0x0e, 0x15, 0x04, 0x00}, // '*'
+	{0x00, 0x04, 0x04, 0x1f, 0x04, 0x04, 0x00}, // '+'
+	{0x00, 0x00, 0x00, 0x00, 0x0c, 0x04, 0x08}, // ','
+	{0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00}, // '-'
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c}, // '.'
+	{0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, // '/'
+	{0x0e, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0e}, // '0'
+	{0x04, 0x0c, 0x04, 0x04, 0x04, 0x04, 0x0e}, // '1'
+	{0x0e, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1f}, // '2'
+	{0x1f, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0e}, // '3'
+	{0x02, 0x06, 0x0a, 0x12, 0x1f, 0x02, 0x02}, // '4'
+	{0x1f, 0x10, 0x1e, 0x01, 0x01, 0x11, 0x0e}, // '5'
+	{0x06, 0x08, 0x10, 0x1e, 0x11, 0x11, 0x0e}, // '6'
+	{0x1f, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // '7'
+	{0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e}, // '8'
+	{0x0e, 0x11, 0x11, 0x0f, 0x01, 0x02, 0x0c}, // '9'
+	{0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x0c, 0x00}, // ':'
+	{0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x04, 0x08}, // ';'
+	{0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}, // '<'
+	{0x00, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00}, // '='
+	{0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}, // '>'
+	{0x0e, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // '?'
+	{0x0e, 0x11, 0x01, 0x0d, 0x15, 0x15, 0x0e}, // '@'
+	{0x0e, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11}, // 'A'
+	{0x1e, 0x11, 0x11, 0x1e, 0x11, 0x11, 0x1e}, // 'B'
+	{0x0e, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0e}, // 'C'
+	{0x1c, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1c}, // 'D'
+	{0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x1f}, // 'E'
+	{0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x10}, // 'F'
+	{0x0e, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0f}, // 'G'
+	{0x11, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11}, // 'H'
+	{0x0e, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e}, // 'I'
+	{0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0c}, // 'J'
+	{0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, // 'K'
+	{0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1f}, // 'L'
+	{0x11, 0x1b, 0x15, 0x15, 0x11, 0x11, 0x11}, // 'M'
+	{0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, // 'N'
+	{0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e}, // 'O'
+	{0x1e, 0x11, 0x11, 0x1e, 0x10, 0x10, 0x10}, // 'P'
+	{0x0e, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0d}, // 'Q'
+	{0x1e, 0x11, 0x11, 0x1e, 0x14, 0x12, 0x11}, // 'R'
+	{0x0f, 0x10, 0x10, 0x0e, 0x01, 0x01, 0x1e}, // 'S'
+	{0x1f, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // 'T'
+	{0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e}, // 'U'
+	{0x11, 0x11, 0x11, 0x11, 0x11, 0x0a, 0x04}, // 'V'
+	{0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0a}, // 'W'
+	{0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11}, // 'X'
+	{0x11, 0x11, 0x11, 0x0a, 0x04, 0x04, 0x04}, // 'Y'
+	{0x1f, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1f}, // 'Z'
+	{0x0e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0e}, // '['
+	{0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00}, // backslash
+	{0x0e, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0e}, // ']'
+	{0x04, 0x0a, 0x11, 0x00, 0x00, 0x00, 0x00}, // '^'
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f}, // '_'
+};
+
+static void
+InitializeTextRenderer(struct app_state *AppState)
+{
+	struct text_state *Text = &AppState->Text;
+	struct glyph_atlas *Atlas = &Text->Atlas;
+
+	Atlas->GlyphAdvance = (FONT_GLYPH_WIDTH + TEXT_GLYPH_SPACING) * TEXT_SCALE;
+	Atlas->GlyphHeight = FONT_GLYPH_HEIGHT * TEXT_SCALE;
+	Atlas->Width = Atlas->GlyphAdvance * FONT_GLYPH_COUNT;
+	Atlas->Coverage = (uint32 *)AppState->PlatformAllocateMemory(Atlas->Width * Atlas->GlyphHeight * sizeof(uint32));
+	if(!Atlas->Coverage)
+	{
+		return;
+	}
+
+	for(int32 GlyphIndex = 0; GlyphIndex < FONT_GLYPH_COUNT; ++GlyphIndex)
+	{
+		for(int32 Y = 0; Y < Atlas->GlyphHeight; ++Y)
+		{
+			uint8 Bits = GlobalFontGlyphs[GlyphIndex][Y / TEXT_SCALE];
+			uint32 *Dest = Atlas->Coverage + (Y * Atlas->Width) + (GlyphIndex * Atlas->GlyphAdvance);
+			for(int32 X = 0; X < FONT_GLYPH_WIDTH * TEXT_SCALE; ++X)
+			{
+				int32 Bit = (FONT_GLYPH_WIDTH - 1) - (X / TEXT_SCALE);
+				Dest[X] = ((Bits >> Bit) & 1) ? 0xffffffff : 0;
+			}
+		}
+	}
+
+	Text->Initialized = true;
+}
+
+inline static int32
+GlyphIndexForChar(char Char)
+{
+	if((Char >= 'a') && (Char <= 'z'))
+	{
+		Char = Char - 'a' + 'A';
+	}
+	if((Char < FONT_FIRST_CHAR) || (Char > FONT_LAST_CHAR))
+	{
+		Char = '?';
+	}
+	int32 Result = Char - FONT_FIRST_CHAR;
+	return(Result);
+}
+
+// NOTE(rick): Returns true when the run had to be re-rasterized.
+static bool32
+UpdateTextRun(struct app_state *AppState, struct text_run *Run, char *String)
+{
+	struct glyph_atlas *Atlas = &AppState->Text.Atlas;
+	if(!Atlas->Coverage || (Run->Coverage && (strcmp(Run->Text, String) == 0)))
+	{
+		return(false);
+	}
+
+	int32 Length = 0;
+	while(String[Length] && (Length < MAX_TEXT_RUN_LENGTH - 1))
+	{
+		Run->Text[Length] = String[Length];
+		++Length;
+	}
+	Run->Text[Length] = 0;
+
+	int32 Width = Length * Atlas->GlyphAdvance;
+	int32 Height = Atlas->GlyphHeight;
+	if((Width * Height > Run->Capacity) || !Run->Coverage)
+	{
+		if(Run->Coverage)
+		{
+			AppState->PlatformFreeMemory(Run->Coverage);
+		}
+		// NOTE(rick): Leave room for a few more glyphs so a run that grows by a
+		// character or two doesn't reallocate every time.
+		Run->Capacity = (Length + 8) * Atlas->GlyphAdvance * Height;
+		Run->Coverage = (uint32 *)AppState->PlatformAllocateMemory(Run->Capacity * sizeof(uint32));
+		if(!Run->Coverage)
+		{
+			Run->Capacity = 0;
+			Run->Width = 0;
+			return(false);
+		}
+	}
+
+	Run->Width = Width;
+	Run->Height = Height;
+	uint32 GlyphRowSize = Atlas->GlyphAdvance * sizeof(uint32);
+	for(int32 Y = 0; Y < Height; ++Y)
+	{
+		uint32 *Dest = Run->Coverage + (Y * Width);
+		uint32 *AtlasRow = Atlas->Coverage + (Y * Atlas->Width);
+		for(int32 CharIndex = 0; CharIndex < Length; ++CharIndex)
+		{
+			memcpy(Dest, AtlasRow + (GlyphIndexForChar(Run->Text[CharIndex]) * Atlas->GlyphAdvance), GlyphRowSize);
+			Dest += Atlas->GlyphAdvance;
+		}
+	}
+
+	return(true);
+}
+
+// NOTE(rick): Four screen pixels at a time,
+// Dest = (Coverage & Color) | (~Coverage & Dest).
+static void
+DrawTextRun(struct game_screen_buffer *Buffer, struct text_run *Run, int32 X, int32 Y, v4 Color)
+{
+	int32 MinX = X;
+	int32 MinY = Y;
+	int32 MaxX = X + Run->Width;
+	int32 MaxY = Y + Run->Height;
+	if(MinX < 0) { MinX = 0; }
+	if(MinY < 0) { MinY = 0; }
+	if(MaxX > Buffer->Width) { MaxX = Buffer->Width; }
+	if(MaxY > Buffer->Height) { MaxY = Buffer->Height; }
+	if((MinX >= MaxX) || (MinY >= MaxY) || !Run->Coverage)
+	{
+		return;
+	}
+
+	uint32 PixelColor = V4ToU32Pixel(Color);
+	__m128i ColorWide = _mm_set1_epi32((int32)PixelColor);
+	int32 Count = MaxX - MinX;
+	for(int32 Row = MinY; Row < MaxY; ++Row)
+	{
+		uint32 *Dest = (uint32 *)((uint8 *)Buffer->BitmapMemory + (Row * Buffer->Pitch)) + MinX;
+		uint32 *Coverage = Run->Coverage + ((Row - Y) * Run->Width) + (MinX - X);
+
+		int32 Index = 0;
+		for(; Index + 4 <= Count; Index += 4)
+		{
+			__m128i Mask = _mm_loadu_si128((__m128i *)(Coverage + Index));
+			__m128i Existing = _mm_loadu_si128((__m128i *)(Dest + Index));
+			__m128i Blended = _mm_or_si128(_mm_and_si128(Mask, ColorWide),
+										   _mm_andnot_si128(Mask, Existing));
+			_mm_storeu_si128((__m128i *)(Dest + Index), Blended);
+		}
+		for(; Index < Count; ++Index)
+		{
+			Dest[Index] = (Coverage[Index] & PixelColor) | (~Coverage[Index] & Dest[Index]);
+		}
+	}
+}
+
+inline static char *
+EditorToolName(enum editor_tool Tool)
+{
+	char *Result = "?";
+	switch(Tool)
+	{
+		case EditorTool_Pencil: { Result = "Pencil"; } break;
+		case EditorTool_RectangleSelect: { Result = "Select"; } break;
+		case EditorTool_LassoSelect: { Result = "Lasso"; } break;
+		case EditorTool_Move: { Result = "Move"; } break;
+		case EditorTool_Line: { Result = "Line"; } break;
+		case EditorTool_Rectangle: { Result = "Rectangle"; } break;
+		case EditorTool_Ellipse: { Result = "Ellipse"; } break;
+		case EditorTool_Gradient: { Result = "Gradient"; } break;
+	}
+	return(Result);
+}
+
+// NOTE(rick): One run per field, so only the fields that actually changed
+// (usually the cursor and the timings) get re-rasterized, the rest are just
+// copied to the screen.
+static void
+DrawStatusOverlay(struct game_screen_buffer *Buffer, struct app_state *AppState, struct app_input *Input)
+{
+	struct text_state *Text = &AppState->Text;
+	if(!Text->Initialized)
+	{
+		return;
+	}
+
+	char Field[StatusField_Count][MAX_TEXT_RUN_LENGTH] = {0};
+	snprintf(Field[StatusField_Canvas], MAX_TEXT_RUN_LENGTH, "%ux%u%s",
+			 AppState->PixelMapWidth, AppState->PixelMapHeight, AppState->Wrap.Enabled ? " Wrap" : "");
+	snprintf(Field[StatusField_Zoom], MAX_TEXT_RUN_LENGTH, "Zoom %d", (int32)AppState->PixelMapZoom);
+
+	int32 GridX = 0;
+	int32 GridY = 0;
+	ScreenToPixelMapGrid(AppState, Input->MouseX, Input->MouseY, &GridX, &GridY);
+	if(AppState->Wrap.Enabled)
+	{
+		GridX = WrapCoordinate(GridX, AppState->PixelMapWidth);
+		GridY = WrapCoordinate(GridY, AppState->PixelMapHeight);
+	}
+	if(ActionPerformedWithinRegion(true, Input->MouseX, Input->MouseY,
+								   AppState->EditingAreaOffset.x, AppState->EditingAreaOffset.y,
+								   AppState->EditingAreaSize.x, AppState->EditingAreaSize.y) &&
+	   (GridX >= 0) && (GridX < (int32)AppState->PixelMapWidth) &&
+	   (GridY >= 0) && (GridY < (int32)AppState->PixelMapHeight))
+	{
+		snprintf(Field[StatusField_Cursor], MAX_TEXT_RUN_LENGTH, "Cell %d,%d", GridX, GridY);
+	}
+	else
+	{
+		snprintf(Field[StatusField_Cursor], MAX_TEXT_RUN_LENGTH, "Cell -");
+	}
+
+	if(AppState->Tool == EditorTool_Gradient)
+	{
+		snprintf(Field[StatusField_Tool], MAX_TEXT_RUN_LENGTH, "%s (%s, %s %d)", EditorToolName(AppState->Tool),
+				 (AppState->Gradient.Kind == GradientKind_Linear) ? "Linear" : "Radial",
+				 (AppState->Gradient.Dither == GradientDither_Bayer) ? "Bayer" : "Steps",
+				 AppState->Gradient.Steps);
+	}
+	else
+	{
+		snprintf(Field[StatusField_Tool], MAX_TEXT_RUN_LENGTH, "%s%s", EditorToolName(AppState->Tool),
+				 (IsShapeTool(AppState->Tool) && AppState->Shape.Filled) ? " (Filled)" : "");
+	}
+	snprintf(Field[StatusField_Frame], MAX_TEXT_RUN_LENGTH, "Frame %d/%d",
+			 AppState->Animation.CurrentFrame + 1, AppState->Animation.FrameCount);
+	snprintf(Field[StatusField_Tolerance], MAX_TEXT_RUN_LENGTH, "Tolerance %d", (int32)AppState->RecolorTolerance);
+	if(AppState->Reference.Pixels)
+	{
+		snprintf(Field[StatusField_Reference], MAX_TEXT_RUN_LENGTH, "Ref %s %d%%",
+				 ReferenceModeName(AppState->Reference.Mode), (int32)((AppState->Reference.Opacity * 100.0f) + 0.5f));
+	}
+	else
+	{
+		snprintf(Field[StatusField_Reference], MAX_TEXT_RUN_LENGTH, "Ref -");
+	}
+	snprintf(Field[StatusField_Timing], MAX_TEXT_RUN_LENGTH, "%.1fms upd %.1fms",
+			 Input->LastFrameMS, Input->LastUpdateMS);
+
+	// NOTE(rick): Editing state on the first line, animation and timings on the
+	// second.
+	int32 X = (int32)AppState->StatusPosition.x;
+	int32 Y = (int32)AppState->StatusPosition.y;
+	for(int32 FieldIndex = 0; FieldIndex < StatusField_Count; ++FieldIndex)
+	{
+		if(FieldIndex == StatusField_Frame)
+		{
+			X = (int32)AppState->StatusPosition.x;
+			Y += Text->Atlas.GlyphHeight + 4;
+		}
+
+		struct text_run *Run = Text->StatusRuns + FieldIndex;
+		UpdateTextRun(AppState, Run, Field[FieldIndex]);
+		DrawTextRun(Buffer, Run, X, Y, V4(0xcc, 0xcc, 0xcc, 0xff));
+		X += Run->Width + (2 * Text->Atlas.GlyphAdvance);
+	}
+}
@@ -0,0 +1,61 @@
+#ifndef PIXEL_EDITOR_TEXT_H
+
+// NOTE(rick): Built-in 5x7 bitmap font covering ' ' through '_'. Lowercase
+// letters draw with the uppercase glyphs and anything else outside the range
+// draws as '?'.
+#define FONT_GLYPH_WIDTH 5
+#define FONT_GLYPH_HEIGHT 7
+#define FONT_FIRST_CHAR ' '
+#define FONT_LAST_CHAR '_'
+#define FONT_GLYPH_COUNT (FONT_LAST_CHAR - FONT_FIRST_CHAR + 1)
+
+#define TEXT_SCALE 2
+#define TEXT_GLYPH_SPACING 1
+#define MAX_TEXT_RUN_LENGTH 64
+
+// NOTE(rick): Every glyph pre-rasterized at TEXT_SCALE into one strip of
+// coverage masks, 0xffffffff where the glyph is lit and 0 elsewhere. Each cell
+// already includes the spacing to the next glyph, so a row of text is built by
+// copying whole cell rows side by side.
+struct glyph_atlas
+{
+	int32 GlyphAdvance;
+	int32 GlyphHeight;
+	int32 Width;
+	uint32 *Coverage;
+};
+
+// NOTE(rick): A string rasterized once into a coverage mask. The mask is only
+// rebuilt when the text changes, drawing it is a masked copy per row.
+struct text_run
+{
+	char Text[MAX_TEXT_RUN_LENGTH];
+	int32 Width;
+	int32 Height;
+	int32 Capacity;
+	uint32 *Coverage;
+};
+
+enum status_field
+{
+	StatusField_Canvas,
+	StatusField_Zoom,
+	StatusField_Cursor,
+	StatusField_Tool,
+	StatusField_Frame,
+	StatusField_Tolerance,
+	StatusField_Reference,
+	StatusField_Timing,
+
+	StatusField_Count,
+};
+
+struct text_state
+{
+	bool32 Initialized;
+	struct glyph_atlas Atlas;
+	struct text_run StatusRuns[StatusField_Count];
+};
+
+#define PIXEL_EDITOR_TEXT_H
+#endif
@@ -0,0 +1,279 @@
+#include <stdarg.h>
+#include "pixeleditor_timing.h"
+
+static inline real64
+TimingTicksToMS(struct frame_timing *Timing, uint64 Ticks)
+{
+	real64 Result = ((real64)Ticks * 1000.0) / (real64)Timing->Frequency;
+	return(Result);
+}
+
+static inline real64
+TimingTimestampToUS(struct frame_timing *Timing, uint64 Timestamp)
+{
+	real64 Result = 0.0;
+	if(Timestamp > Timing->FirstTimestamp)
+	{
+		Result = ((real64)(Timestamp - Timing->FirstTimestamp) * 1000000.0) / (real64)Timing->Frequency;
+	}
+	return(Result);
+}
+
+static void
+AddHistogramSample(struct timing_histogram *Histogram, real64 MS)
+{
+	int32 Bucket = (int32)(MS / TIMING_HISTOGRAM_BUCKET_MS);
+	if(Bucket < 0)
+	{
+		Bucket = 0;
+	}
+
+	if(Bucket < TIMING_HISTOGRAM_BUCKET_COUNT)
+	{
+		++Histogram->Counts[Bucket];
+	}
+	else
+	{
+		++Histogram->OverflowCount;
+	}
+
+	++Histogram->TotalCount;
+	if(MS > Histogram->MaxMS)
+	{
+		Histogram->MaxMS = MS;
+	}
+}
+
+// NOTE(rick): Returns the upper edge of the bucket holding the requested
+// percentile, so the answer is accurate to one bucket width.
+static real64
+GetHistogramPercentile(struct timing_histogram *Histogram, real64 Percentile)
+{
+	real64 Result = 0.0;
+	if(Histogram->TotalCount > 0)
+	{
+		uint32 Target = (uint32)ceil((Percentile / 100.0) * Histogram->TotalCount);
+		if(Target < 1)
+		{
+			Target = 1;
+		}
+
+		Result = Histogram->MaxMS;
+		uint32 Seen = 0;
+		for(int32 Bucket = 0; Bucket < TIMING_HISTOGRAM_BUCKET_COUNT; ++Bucket)
+		{
+			Seen += Histogram->Counts[Bucket];
+			if(Seen >= Target)
+			{
+				Result = (Bucket + 1) * TIMING_HISTOGRAM_BUCKET_MS;
+				if(Result > Histogram->MaxMS)
+				{
+					Result = Histogram->MaxMS;
+				}
+				break;
+			}
+		}
+	}
+	return(Result);
+}
+
+static void
+BeginFrameTiming(struct frame_timing *Timing, uint64 Now)
+{
+	if(Timing->FrameCount == 0)
+	{
+		Timing->FirstTimestamp = Now;
+	}
+
+	struct traced_frame *Frame = Timing->Frames + (Timing->FrameCount % MAX_TRACED_FRAMES);
+	struct traced_frame Empty = {0};
+	*Frame = Empty;
+	Frame->FrameIndex = Timing->FrameCount++;
+	Frame->StageStart[FrameStage_Input] = Now;
+	Timing->CurrentFrame = Frame;
+}
+
+static inline void
+MarkFrameStage(struct frame_timing *Timing, enum frame_stage Stage, uint64 Now)
+{
+	if(Timing->CurrentFrame)
+	{
+		Timing->CurrentFrame->StageStart[Stage] = Now;
+	}
+}
+
+static void
+RecordInputEvent(struct frame_timing *Timing, uint64 EventTime)
+{
+	struct traced_frame *Frame = Timing->CurrentFrame;
+	if(Frame && (Frame->InputEventCount < MAX_INPUT_EVENTS_PER_FRAME))
+	{
+		Frame->InputEventTime[Frame->InputEventCount++] = EventTime;
+	}
+}
+
+// NOTE(rick): Every input event gathered this frame is first visible in this
+// present, so each one contributes an input-to-present sample.
+static void
+MarkFramePresented(struct frame_timing *Timing, uint64 Now)
+{
+	struct traced_frame *Frame = Timing->CurrentFrame;
+	if(Frame)
+	{
+		Frame->PresentTime = Now;
+		for(uint32 EventIndex = 0; EventIndex < Frame->InputEventCount; ++EventIndex)
+		{
+			uint64 EventTime = Frame->InputEventTime[EventIndex];
+			if(EventTime <= Now)
+			{
+				AddHistogramSample(&Timing->InputLatency, TimingTicksToMS(Timing, Now - EventTime));
+			}
+		}
+	}
+}
+
+static void
+EndFrameTiming(struct frame_timing *Timing, uint64 Now)
+{
+	struct traced_frame *Frame = Timing->CurrentFrame;
+	if(Frame)
+	{
+		Frame->FrameEnd = Now;
+		AddHistogramSample(&Timing->FrameTimes, TimingTicksToMS(Timing, Now - Frame->StageStart[FrameStage_Input]));
+	}
+}
+
+struct timing_text
+{
+	char *Base;
+	uint32 Size;
+	uint32 Used;
+};
+
+static void
+AppendTimingText(struct timing_text *Text, char *Format, ...)
+{
+	if(Text->Used < Text->Size)
+	{
+		va_list Args;
+		va_start(Args, Format);
+		int32 Written = vsnprintf(Text->Base + Text->Used, Text->Size - Text->Used, Format, Args);
+		va_end(Args);
+
+		if(Written > 0)
+		{
+			Text->Used += Written;
+			if(Text->Used > Text->Size)
+			{
+				Text->Used = Text->Size;
+			}
+		}
+	}
+}
+
+static void
+FormatTimingSummary(struct frame_timing *Timing, char *Buffer, uint32 BufferSize)
+{
+	snprintf(Buffer, BufferSize,
+			 "frame ms p50 %.2f p95 %.2f p99 %.2f max %.2f | "
+			 "input-to-present ms p50 %.2f p95 %.2f p99 %.2f max %.2f (%u samples, +/-%.1f)\n",
+			 GetHistogramPercentile(&Timing->FrameTimes, 50.0),
+			 GetHistogramPercentile(&Timing->FrameTimes, 95.0),
+			 GetHistogramPercentile(&Timing->FrameTimes, 99.0),
+			 Timing->FrameTimes.MaxMS,
+			 GetHistogramPercentile(&Timing->InputLatency, 50.0),
+			 GetHistogramPercentile(&Timing->InputLatency, 95.0),
+			 GetHistogramPercentile(&Timing->InputLatency, 99.0),
+			 Timing->InputLatency.MaxMS,
+			 Timing->InputLatency.TotalCount,
+			 Timing->InputClockResolutionMS);
+}
+
+static void
+AppendHistogramJSON(struct timing_text *Text, char *Name, struct timing_histogram *Histogram)
+{
+	AppendTimingText(Text, "\"%s\":{\"samples\":%u,\"p50\":%.3f,\"p95\":%.3f,\"p99\":%.3f,\"max\":%.3f}",
+					 Name, Histogram->TotalCount,
+					 GetHistogramPercentile(Histogram, 50.0),
+					 GetHistogramPercentile(Histogram, 95.0),
+					 GetHistogramPercentile(Histogram, 99.0),
+					 Histogram->MaxMS);
+}
+
+// NOTE(rick): Writes the most recent frames in the Trace Event JSON format, which
+// loads straight into chrome://tracing or Perfetto. Frame stages go on one
+// track and input-to-present spans on another; the histogram percentiles are
+// stored under otherData.
+static bool32
+WriteFrameTimingTrace(struct frame_timing *Timing, char *Filename,
+					  platform_allocate_memory *PlatformAllocateMemory,
+					  platform_write_file *PlatformWriteFile,
+					  platform_free_memory *PlatformFreeMemory)
+{
+	char *StageNames[FrameStage_Count] = { "Input", "UpdateAndRender", "Present", "Wait" };
+
+	uint64 FirstFrame = 0;
+	if(Timing->FrameCount > MAX_TRACED_FRAMES)
+	{
+		FirstFrame = Timing->FrameCount - MAX_TRACED_FRAMES;
+	}
+	// NOTE(rick): The frame in flight has no end time yet, leave it out.
+	uint64 LastFrame = (Timing->FrameCount > 0) ? (Timing->FrameCount - 1) : 0;
+
+	struct timing_text Text = {0};
+	Text.Size = 4096 + (MAX_TRACED_FRAMES * (FrameStage_Count + MAX_INPUT_EVENTS_PER_FRAME) * 160);
+	Text.Base = (char *)PlatformAllocateMemory(Text.Size);
+	if(!Text.Base)
+	{
+		return(false);
+	}
+
+	AppendTimingText(&Text, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	AppendTimingText(&Text, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Frame\"}},\n");
+	AppendTimingText(&Text, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"Input to present\"}}");
+
+	for(uint64 FrameIndex = FirstFrame; FrameIndex < LastFrame; ++FrameIndex)
+	{
+		struct traced_frame *Frame = Timing->Frames + (FrameIndex % MAX_TRACED_FRAMES);
+		for(int32 Stage = 0; Stage < FrameStage_Count; ++Stage)
+		{
+			uint64 Start = Frame->StageStart[Stage];
+			uint64 End = (Stage + 1 < FrameStage_Count) ? Frame->StageStart[Stage + 1] : Frame->FrameEnd;
+			if((Start == 0) || (End < Start))
+			{
+				continue;
+			}
+
+			AppendTimingText(&Text, ",\n{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+							 "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%llu}}",
+							 StageNames[Stage],
+							 TimingTimestampToUS(Timing, Start),
+							 TimingTimestampToUS(Timing, End) - TimingTimestampToUS(Timing, Start),
+							 (unsigned long long)Frame->FrameIndex);
+		}
+
+		for(uint32 EventIndex = 0; EventIndex < Frame->InputEventCount; ++EventIndex)
+		{
+			uint64 EventTime = Frame->InputEventTime[EventIndex];
+			if(Frame->PresentTime && (EventTime <= Frame->PresentTime))
+			{
+				AppendTimingText(&Text, ",\n{\"name\":\"InputToPresent\",\"cat\":\"input\",\"ph\":\"X\",\"pid\":1,\"tid\":2,"
+								 "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%llu}}",
+								 TimingTimestampToUS(Timing, EventTime),
+								 TimingTimestampToUS(Timing, Frame->PresentTime) - TimingTimestampToUS(Timing, EventTime),
+								 (unsigned long long)Frame->FrameIndex);
+			}
+		}
+	}
+
+	AppendTimingText(&Text, "\n],\"otherData\":{");
+	AppendHistogramJSON(&Text, "frameTimeMS", &Timing->FrameTimes);
+	AppendTimingText(&Text, ",");
+	AppendHistogramJSON(&Text, "inputToPresentMS", &Timing->InputLatency);
+	AppendTimingText(&Text, ",\"inputClockResolutionMS\":%.3f", Timing->InputClockResolutionMS);
+	AppendTimingText(&Text, "}}\n");
+
+	bool32 Result = PlatformWriteFile(Filename, Text.Base, Text.Used);
+	PlatformFreeMemory(Text.Base);
+	return(Result);
+}
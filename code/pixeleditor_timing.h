@@ -0,0 +1,59 @@
+#ifndef PIXEL_EDITOR_TIMING_H
+
+// NOTE(rick): Platform-side frame and input latency bookkeeping. Timestamps
+// are raw performance counter ticks from whatever clock the platform layer
+// uses; Frequency converts them to seconds.
+
+// NOTE(rick): Histograms use fixed 0.1ms buckets up to 100ms, anything slower
+// is only counted towards the overflow bucket and the max.
+#define TIMING_HISTOGRAM_BUCKET_COUNT 1000
+#define TIMING_HISTOGRAM_BUCKET_MS 0.1
+
+#define MAX_TRACED_FRAMES 1024
+#define MAX_INPUT_EVENTS_PER_FRAME 32
+
+struct timing_histogram
+{
+	uint32 Counts[TIMING_HISTOGRAM_BUCKET_COUNT];
+	uint32 OverflowCount;
+	uint32 TotalCount;
+	real64 MaxMS;
+};
+
+enum frame_stage
+{
+	FrameStage_Input,
+	FrameStage_UpdateAndRender,
+	FrameStage_Present,
+	FrameStage_Wait,
+
+	FrameStage_Count,
+};
+
+struct traced_frame
+{
+	uint64 FrameIndex;
+	uint64 StageStart[FrameStage_Count];
+	uint64 FrameEnd;
+	uint64 PresentTime;
+	uint32 InputEventCount;
+	uint64 InputEventTime[MAX_INPUT_EVENTS_PER_FRAME];
+};
+
+struct frame_timing
+{
+	uint64 Frequency;
+	// NOTE(rick): How finely the platform's event times resolve, which bounds
+	// the error of every input-to-present sample. Reported with them.
+	real64 InputClockResolutionMS;
+	uint64 FirstTimestamp;
+	uint64 FrameCount;
+	struct traced_frame Frames[MAX_TRACED_FRAMES];
+	struct traced_frame *CurrentFrame;
+
+	struct timing_histogram FrameTimes;
+	struct timing_histogram InputLatency;
+};
+
+#define PIXEL_EDITOR_TIMING_H
+#endif
@@ -0,0 +1,500 @@
+static inline void
+SwapPixels(v4 *A, v4 *B)
+{
+	__m128 PixelA = _mm_loadu_ps(A->E);
+	__m128 PixelB = _mm_loadu_ps(B->E);
+	_mm_storeu_ps(A->E, PixelB);
+	_mm_storeu_ps(B->E, PixelA);
+}
+
+static void
+ReversePixelRow(v4 *Row, int32 Count)
+{
+	v4 *Left = Row;
+	v4 *Right = Row + Count - 1;
+	for(; Left + 1 < Right - 1; Left += 2, Right -= 2)
+	{
+		__m128 L0 = _mm_loadu_ps(Left[0].E);
+		__m128 L1 = _mm_loadu_ps(Left[1].E);
+		__m128 R0 = _mm_loadu_ps(Right[0].E);
+		__m128 R1 = _mm_loadu_ps(Right[-1].E);
+		_mm_storeu_ps(Left[0].E, R0);
+		_mm_storeu_ps(Left[1].E, R1);
+		_mm_storeu_ps(Right[0].E, L0);
+		_mm_storeu_ps(Right[-1].E, L1);
+	}
+	for(; Left < Right; ++Left, --Right)
+	{
+		SwapPixels(Left, Right);
+	}
+}
+
+static void
+SwapPixelRows(v4 *A, v4 *B, int32 Count, bool32 Reversed)
+{
+	if(!Reversed)
+	{
+		for(int32 X = 0; X < Count; ++X)
+		{
+			SwapPixels(A + X, B + X);
+		}
+	}
+	else
+	{
+		for(int32 X = 0; X < Count; ++X)
+		{
+			SwapPixels(A + X, B + (Count - 1 - X));
+		}
+	}
+}
+
+// NOTE(rick): Square buffers are transposed in place by swapping each tile
+// above the diagonal with its mirror below it. Diagonal tiles are transposed
+// within themselves.
+static void
+TransposeSquarePixelBuffer(struct pixel_buffer *Buffer)
+{
+	Assert(Buffer->Width == Buffer->Height);
+	int32 Size = Buffer->Width;
+	for(int32 TileY = 0; TileY < Size; TileY += TRANSPOSE_TILE_SIZE)
+	{
+		int32 TileMaxY = TileY + TRANSPOSE_TILE_SIZE;
+		if(TileMaxY > Size) { TileMaxY = Size; }
+		for(int32 TileX = TileY; TileX < Size; TileX += TRANSPOSE_TILE_SIZE)
+		{
+			int32 TileMaxX = TileX + TRANSPOSE_TILE_SIZE;
+			if(TileMaxX > Size) { TileMaxX = Size; }
+			for(int32 Y = TileY; Y < TileMaxY; ++Y)
+			{
+				v4 *Row = PixelBufferRow(Buffer, Y);
+				int32 MinX = (TileX == TileY) ? (Y + 1) : TileX;
+				for(int32 X = MinX; X < TileMaxX; ++X)
+				{
+					SwapPixels(Row + X, PixelBufferRow(Buffer, X) + Y);
+				}
+			}
+		}
+	}
+}
+
+static void
+TransposePixelBufferInto(struct pixel_buffer *Dest, struct pixel_buffer *Source)
+{
+	Assert((Dest->Width == Source->Height) && (Dest->Height == Source->Width));
+	for(int32 TileY = 0; TileY < Source->Height; TileY += TRANSPOSE_TILE_SIZE)
+	{
+		int32 TileMaxY = TileY + TRANSPOSE_TILE_SIZE;
+		if(TileMaxY > Source->Height) { TileMaxY = Source->Height; }
+		for(int32 TileX = 0; TileX < Source->Width; TileX += TRANSPOSE_TILE_SIZE)
+		{
+			int32 TileMaxX = TileX + TRANSPOSE_TILE_SIZE;
+			if(TileMaxX > Source->Width) { TileMaxX = Source->Width; }
+			for(int32 Y = TileY; Y < TileMaxY; ++Y)
+			{
+				v4 *SourceRow = PixelBufferRow(Source, Y);
+				for(int32 X = TileX; X < TileMaxX; ++X)
+				{
+					_mm_storeu_ps((PixelBufferRow(Dest, X) + Y)->E, _mm_loadu_ps(SourceRow[X].E));
+				}
+			}
+		}
+	}
+}
+
+static void
+FlipPixelBufferHorizontal(struct pixel_buffer *Buffer)
+{
+	for(int32 Y = 0; Y < Buffer->Height; ++Y)
+	{
+		ReversePixelRow(PixelBufferRow(Buffer, Y), Buffer->Width);
+	}
+}
+
+static void
+FlipPixelBufferVertical(struct pixel_buffer *Buffer, bool32 AlsoHorizontal)
+{
+	int32 Top = 0;
+	int32 Bottom = Buffer->Height - 1;
+	for(; Top < Bottom; ++Top, --Bottom)
+	{
+		SwapPixelRows(PixelBufferRow(Buffer, Top), PixelBufferRow(Buffer, Bottom), Buffer->Width, AlsoHorizontal);
+	}
+	if((Top == Bottom) && AlsoHorizontal)
+	{
+		ReversePixelRow(PixelBufferRow(Buffer, Top), Buffer->Width);
+	}
+}
+
+// NOTE(rick): Buffer must own its memory (Pitch == Width). Flips and square
+// rotations happen in place, rotating a non-square buffer needs a second
+// buffer for the transpose and frees the original afterwards.
+static bool32
+TransformPixelBuffer(struct app_state *AppState, struct pixel_buffer *Buffer, enum pixel_transform Transform)
+{
+	Assert(Buffer->Pitch == Buffer->Width);
+	bool32 Result = true;
+
+	switch(Transform)
+	{
+		case PixelTransform_FlipHorizontal:
+		{
+			FlipPixelBufferHorizontal(Buffer);
+		} break;
+		case PixelTransform_FlipVertical:
+		{
+			FlipPixelBufferVertical(Buffer, false);
+		} break;
+		case PixelTransform_Rotate180:
+		{
+			FlipPixelBufferVertical(Buffer, true);
+		} break;
+		case PixelTransform_Rotate90:
+		case PixelTransform_Rotate270:
+		{
+			if(Buffer->Width == Buffer->Height)
+			{
+				TransposeSquarePixelBuffer(Buffer);
+			}
+			else
+			{
+				struct pixel_buffer Transposed = {0};
+				Result = AllocatePixelBuffer(AppState, &Transposed, Buffer->Height, Buffer->Width);
+				if(Result)
+				{
+					TransposePixelBufferInto(&Transposed, Buffer);
+					FreePixelBuffer(AppState, Buffer);
+					*Buffer = Transposed;
+				}
+			}
+
+			if(Result)
+			{
+				if(Transform == PixelTransform_Rotate90)
+				{
+					FlipPixelBufferHorizontal(Buffer);
+				}
+				else
+				{
+					FlipPixelBufferVertical(Buffer, false);
+				}
+			}
+		} break;
+	}
+
+	return(Result);
+}
+
+// NOTE(rick): Nearest-neighbour integer scale. Upscaling expands each source
+// row once and then copies the expanded row down, downscaling keeps the top
+// left pixel of each block and runs in place since every destination pixel
+// sits at or before its source.
+static bool32
+ScalePixelBuffer(struct app_state *AppState, struct pixel_buffer *Buffer, int32 Factor, bool32 Up)
+{
+	Assert(Buffer->Pitch == Buffer->Width);
+	bool32 Result = false;
+
+	if(Up)
+	{
+		struct pixel_buffer Scaled = {0};
+		if(((Buffer->Width * Factor) <= MAX_CANVAS_DIMENSION) &&
+		   ((Buffer->Height * Factor) <= MAX_CANVAS_DIMENSION) &&
+		   AllocatePixelBuffer(AppState, &Scaled, Buffer->Width * Factor, Buffer->Height * Factor))
+		{
+			for(int32 Y = 0; Y < Buffer->Height; ++Y)
+			{
+				v4 *SourceRow = PixelBufferRow(Buffer, Y);
+				v4 *DestRow = PixelBufferRow(&Scaled, Y * Factor);
+				v4 *Dest = DestRow;
+				for(int32 X = 0; X < Buffer->Width; ++X)
+				{
+					__m128 Pixel = _mm_loadu_ps(SourceRow[X].E);
+					for(int32 Repeat = 0; Repeat < Factor; ++Repeat)
+					{
+						_mm_storeu_ps((Dest++)->E, Pixel);
+					}
+				}
+
+				for(int32 Repeat = 1; Repeat < Factor; ++Repeat)
+				{
+					BlitRowCopy(DestRow + (Repeat * Scaled.Pitch), DestRow, Scaled.Width, false);
+				}
+			}
+
+			FreePixelBuffer(AppState, Buffer);
+			*Buffer = Scaled;
+			Result = true;
+		}
+	}
+	else
+	{
+		int32 Width = Buffer->Width / Factor;
+		int32 Height = Buffer->Height / Factor;
+		if((Width > 0) && (Height > 0))
+		{
+			v4 *Dest = Buffer->Pixels;
+			for(int32 Y = 0; Y < Height; ++Y)
+			{
+				v4 *SourceRow = PixelBufferRow(Buffer, Y * Factor);
+				for(int32 X = 0; X < Width; ++X)
+				{
+					_mm_storeu_ps((Dest++)->E, _mm_loadu_ps(SourceRow[X * Factor].E));
+				}
+			}
+
+			Buffer->Width = Width;
+			Buffer->Height = Height;
+			Buffer->Pitch = Width;
+			Result = true;
+		}
+	}
+
+	return(Result);
+}
+
+// NOTE(rick): Masks are cheap enough to remap one bit at a time, so every
+// destination bit just looks up where it came from.
+static bool32
+TransformPixelMask(struct app_state *AppState, struct pixel_mask *Mask, enum pixel_transform Transform)
+{
+	bool32 Swapped = ((Transform == PixelTransform_Rotate90) || (Transform == PixelTransform_Rotate270));
+	int32 Width = Swapped ? Mask->Height : Mask->Width;
+	int32 Height = Swapped ? Mask->Width : Mask->Height;
+
+	struct pixel_mask Result = {0};
+	if(!AllocatePixelMask(AppState, &Result, Width, Height))
+	{
+		return(false);
+	}
+
+	for(int32 Y = 0; Y < Height; ++Y)
+	{
+		for(int32 X = 0; X < Width; ++X)
+		{
+			int32 SourceX = X;
+			int32 SourceY = Y;
+			switch(Transform)
+			{
+				case PixelTransform_Rotate90: { SourceX = Y; SourceY = Width - 1 - X; } break;
+				case PixelTransform_Rotate180: { SourceX = Width - 1 - X; SourceY = Height - 1 - Y; } break;
+				case PixelTransform_Rotate270: { SourceX = Height - 1 - Y; SourceY = X; } break;
+				case PixelTransform_FlipHorizontal: { SourceX = Width - 1 - X; } break;
+				case PixelTransform_FlipVertical: { SourceY = Height - 1 - Y; } break;
+			}
+
+			if(IsPixelMaskSet(Mask, SourceX, SourceY))
+			{
+				WritePixelMaskSpan(&Result, Y, X, X + 1, true);
+			}
+		}
+	}
+
+	FreePixelMask(AppState, Mask);
+	*Mask = Result;
+	return(true);
+}
+
+static bool32
+ScalePixelMask(struct app_state *AppState, struct pixel_mask *Mask, int32 Factor, bool32 Up)
+{
+	int32 Width = Up ? (Mask->Width * Factor) : (Mask->Width / Factor);
+	int32 Height = Up ? (Mask->Height * Factor) : (Mask->Height / Factor);
+
+	struct pixel_mask Result = {0};
+	if(!AllocatePixelMask(AppState, &Result, Width, Height))
+	{
+		return(false);
+	}
+
+	for(int32 Y = 0; Y < Height; ++Y)
+	{
+		for(int32 X = 0; X < Width; ++X)
+		{
+			int32 SourceX = Up ? (X / Factor) : (X * Factor);
+			int32 SourceY = Up ? (Y / Factor) : (Y * Factor);
+			if(IsPixelMaskSet(Mask, SourceX, SourceY))
+			{
+				WritePixelMaskSpan(&Result, Y, X, X + 1, true);
+			}
+		}
+	}
+
+	FreePixelMask(AppState, Mask);
+	*Mask = Result;
+	return(true);
+}
+
+static bool32
+ApplyCanvasTransform(struct app_state *AppState, struct pixel_buffer *Buffer, struct canvas_transform *Op)
+{
+	bool32 Result = false;
+	if(Op->Scale)
+	{
+		Result = ScalePixelBuffer(AppState, Buffer, Op->Factor, Op->Up);
+	}
+	else
+	{
+		Result = TransformPixelBuffer(AppState, Buffer, Op->Transform);
+	}
+	return(Result);
+}
+
+// NOTE(rick): A canvas transform applies to the whole animation, every stored
+// frame gets the same transform as the current one whether or not it changes
+// the dimensions. Canvas is the already transformed current frame; the old
+// dimensions are still in AppState. New
+// grids are built for every frame before any old one is released, so if that
+// runs out of memory the frames are left exactly as they were.
+static bool32
+TransformAnimationFrames(struct app_state *AppState, struct pixel_buffer *Canvas, struct canvas_transform *Op)
+{
+	struct animation_state *Animation = &AppState->Animation;
+	if(!Animation->Initialized)
+	{
+		return(true);
+	}
+
+	int32 TilesX = (Canvas->Width + TILE_SIZE - 1) / TILE_SIZE;
+	int32 TilesY = (Canvas->Height + TILE_SIZE - 1) / TILE_SIZE;
+	uint32 *NewFrameTiles[MAX_ANIMATION_FRAMES] = {0};
+	bool32 Result = true;
+	for(int32 FrameIndex = 0; Result && (FrameIndex < Animation->FrameCount); ++FrameIndex)
+	{
+		uint32 *FrameTiles = AllocateFrameTiles(AppState, TilesX, TilesY);
+		Result = (FrameTiles != 0);
+		if(Result)
+		{
+			NewFrameTiles[FrameIndex] = FrameTiles;
+			if(FrameIndex == Animation->CurrentFrame)
+			{
+				Result = StoreFrameTiles(AppState, FrameTiles, TilesX, TilesY, Canvas);
+			}
+			else
+			{
+				struct pixel_buffer Frame = {0};
+				Result = AllocatePixelBuffer(AppState, &Frame, AppState->PixelMapWidth, AppState->PixelMapHeight);
+				if(Result)
+				{
+					LoadFrame(AppState, FrameIndex, &Frame, 0, 0);
+					Result = (ApplyCanvasTransform(AppState, &Frame, Op) &&
+							  StoreFrameTiles(AppState, FrameTiles, TilesX, TilesY, &Frame));
+					FreePixelBuffer(AppState, &Frame);
+				}
+			}
+		}
+	}
+
+	for(int32 FrameIndex = 0; FrameIndex < Animation->FrameCount; ++FrameIndex)
+	{
+		if(Result)
+		{
+			FreeFrameTiles(AppState, Animation->FrameTiles[FrameIndex], Animation->TilesX * Animation->TilesY);
+			Animation->FrameTiles[FrameIndex] = NewFrameTiles[FrameIndex];
+		}
+		else if(NewFrameTiles[FrameIndex])
+		{
+			FreeFrameTiles(AppState, NewFrameTiles[FrameIndex], TilesX * TilesY);
+		}
+	}
+
+	if(Result)
+	{
+		Animation->TilesX = TilesX;
+		Animation->TilesY = TilesY;
+	}
+	return(Result);
+}
+
+static void
+TransformCanvas(struct app_state *AppState, struct canvas_transform *Op)
+{
+	// NOTE(rick): The stored current frame is what the canvas is put back from
+	// if the other frames can't follow it.
+	if(!SyncCurrentFrame(AppState))
+	{
+		return;
+	}
+
+	struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+	if(ApplyCanvasTransform(AppState, &Canvas, Op))
+	{
+		if(!TransformAnimationFrames(AppState, &Canvas, Op))
+		{
+			// NOTE(rick): A transform that moves the canvas to a new buffer
+			// frees the old one but never shrinks it, so the old frame always
+			// fits back into the new buffer.
+			AppState->PixelMap = Canvas.Pixels;
+			struct pixel_buffer Restored = PixelMapBuffer(AppState);
+			LoadFrame(AppState, AppState->Animation.CurrentFrame, &Restored, 0, 0);
+			return;
+		}
+
+		AppState->PixelMap = Canvas.Pixels;
+		AppState->PixelMapWidth = Canvas.Width;
+		AppState->PixelMapHeight = Canvas.Height;
+		// NOTE(rick): Unlike ResizeCanvas the current zoom is kept, it is only
+		// pulled in if the new size no longer allows it.
+		UpdateMinPixelMapZoom(AppState);
+		if(AppState->PixelMapZoom < AppState->MinPixelMapZoom)
+		{
+			AppState->PixelMapZoom = AppState->MinPixelMapZoom;
+		}
+		UpdatePixelEditorPosition(AppState, NULL);
+	}
+}
+
+// NOTE(rick): Transforms apply to the selection when there is one, otherwise
+// to the whole canvas and every animation frame.
+static void
+TransformCanvasOrSelection(struct app_state *AppState, enum pixel_transform Transform)
+{
+	struct selection_state *Selection = &AppState->Selection;
+	if(Selection->Active)
+	{
+		LiftSelection(AppState);
+		if(Selection->Floating)
+		{
+			int32 OldWidth = Selection->Mask.Width;
+			int32 OldHeight = Selection->Mask.Height;
+			if(TransformPixelBuffer(AppState, &Selection->FloatingPixels, Transform) &&
+			   TransformPixelMask(AppState, &Selection->Mask, Transform))
+			{
+				// NOTE(rick): Rotate about the middle of the selection rather
+				// than its corner.
+				Selection->X += (OldWidth - Selection->Mask.Width) / 2;
+				Selection->Y += (OldHeight - Selection->Mask.Height) / 2;
+			}
+		}
+	}
+	else
+	{
+		struct canvas_transform Op = {0};
+		Op.Transform = Transform;
+		TransformCanvas(AppState, &Op);
+	}
+}
+
+static void
+ScaleCanvasOrSelection(struct app_state *AppState, int32 Factor, bool32 Up)
+{
+	struct selection_state *Selection = &AppState->Selection;
+	if(Selection->Active)
+	{
+		LiftSelection(AppState);
+		if(Selection->Floating)
+		{
+			if(ScalePixelBuffer(AppState, &Selection->FloatingPixels, Factor, Up))
+			{
+				ScalePixelMask(AppState, &Selection->Mask, Factor, Up);
+			}
+		}
+	}
+	else
+	{
+		struct canvas_transform Op = {0};
+		Op.Scale = true;
+		Op.Factor = Factor;
+		Op.Up = Up;
+		TransformCanvas(AppState, &Op);
+	}
+}
@@ -0,0 +1,29 @@
+#ifndef PIXEL_EDITOR_TRANSFORM_H
+
+enum pixel_transform
+{
+	PixelTransform_Rotate90,
+	PixelTransform_Rotate180,
+	PixelTransform_Rotate270,
+	PixelTransform_FlipHorizontal,
+	PixelTransform_FlipVertical,
+};
+
+// NOTE(rick): Square blocks of this many pixels are transposed at a time. Two
+// 16x16 blocks of v4 pixels are 8KB, which sits comfortably in L1.
+#define TRANSPOSE_TILE_SIZE 16
+
+#define MAX_CANVAS_DIMENSION 8192
+
+// NOTE(rick): Either a rotate/flip or an integer scale, so the same operation
+// can be replayed on every animation frame.
+struct canvas_transform
+{
+	bool32 Scale;
+	enum pixel_transform Transform;
+	int32 Factor;
+	bool32 Up;
+};
+
+#define PIXEL_EDITOR_TRANSFORM_H
+#endif
@@ -0,0 +1,374 @@
+// NOTE(rick): Each pixel is xored with a key that moves on per pixel, so
+// pixels trading places still change the hash, and then multiplied sixteen
+// bits at a time with its neighbour. That is one multiply for every two
+// pixels, which keeps hashing well under the cost of the edits it guards.
+static uint64
+HashPixelRow(v4 *Pixels, int32 Count)
+{
+	__m128i KeyA = _mm_set_epi32(0x165667b1, 0x9e3779b9, 0xc2b2ae3d, 0x27d4eb2f);
+	__m128i KeyB = _mm_set_epi32(0x27d4eb4f, 0x7f4a7c15, 0x165667c5, 0x9e3779f9);
+	__m128i KeyStep = _mm_set_epi32(0x2545f491, 0x61c88647, 0x3c6ef372, 0x5851f42d);
+	__m128i Sum = _mm_setzero_si128();
+
+	int32 X = 0;
+	for(; X + 2 <= Count; X += 2)
+	{
+		__m128i A = _mm_xor_si128(_mm_loadu_si128((__m128i *)Pixels[X + 0].E), KeyA);
+		__m128i B = _mm_xor_si128(_mm_loadu_si128((__m128i *)Pixels[X + 1].E), KeyB);
+		Sum = _mm_add_epi32(Sum, _mm_madd_epi16(A, B));
+		KeyA = _mm_add_epi32(KeyA, KeyStep);
+		KeyB = _mm_add_epi32(KeyB, KeyStep);
+	}
+	if(X < Count)
+	{
+		__m128i A = _mm_xor_si128(_mm_loadu_si128((__m128i *)Pixels[X].E), KeyA);
+		Sum = _mm_add_epi32(Sum, _mm_madd_epi16(A, KeyB));
+	}
+
+	uint32 Lanes[4];
+	_mm_storeu_si128((__m128i *)Lanes, Sum);
+	uint64 Hash = (uint64)Count;
+	for(int32 Lane = 0; Lane < 4; ++Lane)
+	{
+		Hash ^= Lanes[Lane];
+		Hash *= 0xff51afd7ed558ccd;
+		Hash ^= (Hash >> 32);
+	}
+	return(Hash);
+}
+
+// NOTE(rick): Packs a row down to a byte per channel. Returns false if any
+// channel isn't a whole value from 0 to 255, in which case Dest holds nothing
+// useful.
+static bool32
+PackPixelRow(uint32 *Dest, v4 *Source, int32 Count)
+{
+	__m128 Whole = _mm_castsi128_ps(_mm_set1_epi32(-1));
+	__m128i Bits = _mm_setzero_si128();
+
+	int32 X = 0;
+	for(; X + 4 <= Count; X += 4)
+	{
+		__m128 Pixel0 = _mm_loadu_ps(Source[X + 0].E);
+		__m128 Pixel1 = _mm_loadu_ps(Source[X + 1].E);
+		__m128 Pixel2 = _mm_loadu_ps(Source[X + 2].E);
+		__m128 Pixel3 = _mm_loadu_ps(Source[X + 3].E);
+		__m128i Channels0 = _mm_cvttps_epi32(Pixel0);
+		__m128i Channels1 = _mm_cvttps_epi32(Pixel1);
+		__m128i Channels2 = _mm_cvttps_epi32(Pixel2);
+		__m128i Channels3 = _mm_cvttps_epi32(Pixel3);
+
+		Whole = _mm_and_ps(Whole, _mm_and_ps(_mm_and_ps(_mm_cmpeq_ps(_mm_cvtepi32_ps(Channels0), Pixel0),
+														_mm_cmpeq_ps(_mm_cvtepi32_ps(Channels1), Pixel1)),
+											 _mm_and_ps(_mm_cmpeq_ps(_mm_cvtepi32_ps(Channels2), Pixel2),
+														_mm_cmpeq_ps(_mm_cvtepi32_ps(Channels3), Pixel3))));
+		Bits = _mm_or_si128(Bits, _mm_or_si128(_mm_or_si128(Channels0, Channels1),
+											   _mm_or_si128(Channels2, Channels3)));
+		_mm_storeu_si128((__m128i *)(Dest + X), _mm_packus_epi16(_mm_packs_epi32(Channels0, Channels1),
+																 _mm_packs_epi32(Channels2, Channels3)));
+	}
+	for(; X < Count; ++X)
+	{
+		__m128 Pixel = _mm_loadu_ps(Source[X].E);
+		__m128i Channels = _mm_cvttps_epi32(Pixel);
+		Whole = _mm_and_ps(Whole, _mm_cmpeq_ps(_mm_cvtepi32_ps(Channels), Pixel));
+		Bits = _mm_or_si128(Bits, Channels);
+		__m128i Words = _mm_packs_epi32(Channels, Channels);
+		Dest[X] = (uint32)_mm_cvtsi128_si32(_mm_packus_epi16(Words, Words));
+	}
+
+	__m128i OutOfRange = _mm_and_si128(Bits, _mm_set1_epi32(~0xff));
+	bool32 Result = ((_mm_movemask_ps(Whole) == 0xF) &&
+					 (_mm_movemask_epi8(_mm_cmpeq_epi32(OutOfRange, _mm_setzero_si128())) == 0xFFFF));
+	return(Result);
+}
+
+static void
+UnpackPixelRow(v4 *Dest, uint32 *Source, int32 Count)
+{
+	__m128i Zero = _mm_setzero_si128();
+
+	int32 X = 0;
+	for(; X + 4 <= Count; X += 4)
+	{
+		__m128i Packed = _mm_loadu_si128((__m128i *)(Source + X));
+		__m128i Low = _mm_unpacklo_epi8(Packed, Zero);
+		__m128i High = _mm_unpackhi_epi8(Packed, Zero);
+		_mm_storeu_ps(Dest[X + 0].E, _mm_cvtepi32_ps(_mm_unpacklo_epi16(Low, Zero)));
+		_mm_storeu_ps(Dest[X + 1].E, _mm_cvtepi32_ps(_mm_unpackhi_epi16(Low, Zero)));
+		_mm_storeu_ps(Dest[X + 2].E, _mm_cvtepi32_ps(_mm_unpacklo_epi16(High, Zero)));
+		_mm_storeu_ps(Dest[X + 3].E, _mm_cvtepi32_ps(_mm_unpackhi_epi16(High, Zero)));
+	}
+	for(; X < Count; ++X)
+	{
+		__m128i Packed = _mm_cvtsi32_si128((int32)Source[X]);
+		__m128i Channels = _mm_unpacklo_epi16(_mm_unpacklo_epi8(Packed, Zero), Zero);
+		_mm_storeu_ps(Dest[X].E, _mm_cvtepi32_ps(Channels));
+	}
+}
+
+static void
+FreeUndoBand(struct app_state *AppState, void **Band)
+{
+	if(*Band)
+	{
+		AppState->PlatformFreeMemory(*Band);
+		*Band = 0;
+	}
+}
+
+static void
+FreeUndo(struct app_state *AppState)
+{
+	struct undo_state *Undo = &AppState->Undo;
+	if(Undo->PackedBands)
+	{
+		for(int32 BandIndex = 0; BandIndex < Undo->BandCount; ++BandIndex)
+		{
+			FreeUndoBand(AppState, (void **)(Undo->PackedBands + BandIndex));
+		}
+		AppState->PlatformFreeMemory(Undo->PackedBands);
+	}
+	if(Undo->WideBands)
+	{
+		for(int32 BandIndex = 0; BandIndex < Undo->BandCount; ++BandIndex)
+		{
+			FreeUndoBand(AppState, (void **)(Undo->WideBands + BandIndex));
+		}
+		AppState->PlatformFreeMemory(Undo->WideBands);
+	}
+	if(Undo->RowSaved)
+	{
+		AppState->PlatformFreeMemory(Undo->RowSaved);
+	}
+	if(Undo->RowHashes)
+	{
+		AppState->PlatformFreeMemory(Undo->RowHashes);
+	}
+	Undo->PackedBands = 0;
+	Undo->WideBands = 0;
+	Undo->BandCount = 0;
+	Undo->Width = 0;
+	Undo->Height = 0;
+	Undo->RowSaved = 0;
+	Undo->RowHashes = 0;
+	Undo->Available = false;
+}
+
+// NOTE(rick): Bands left over from the last edit are kept for this one, so
+// repeating an edit over the same rows doesn't pay for fresh memory each time.
+static bool32
+BeginUndoableEdit(struct app_state *AppState)
+{
+	struct undo_state *Undo = &AppState->Undo;
+	struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+
+	Undo->Available = false;
+	Undo->Incomplete = false;
+	if(!Undo->RowSaved ||
+	   (Undo->Width != Canvas.Width) ||
+	   (Undo->Height != Canvas.Height))
+	{
+		FreeUndo(AppState);
+		Undo->Width = Canvas.Width;
+		Undo->Height = Canvas.Height;
+		Undo->BandCount = (Canvas.Height + UNDO_ROWS_PER_BAND - 1) / UNDO_ROWS_PER_BAND;
+		Undo->PackedBands = (uint32 **)AppState->PlatformAllocateMemory(Undo->BandCount * sizeof(uint32 *));
+		Undo->WideBands = (v4 **)AppState->PlatformAllocateMemory(Undo->BandCount * sizeof(v4 *));
+		Undo->RowSaved = (uint8 *)AppState->PlatformAllocateMemory(Canvas.Height * sizeof(uint8));
+		Undo->RowHashes = (uint64 *)AppState->PlatformAllocateMemory(Canvas.Height * sizeof(uint64));
+		if(!Undo->PackedBands || !Undo->WideBands || !Undo->RowSaved || !Undo->RowHashes)
+		{
+			FreeUndo(AppState);
+			return(false);
+		}
+	}
+	else
+	{
+		memset(Undo->RowSaved, UndoRow_None, Canvas.Height * sizeof(uint8));
+	}
+
+	Undo->Frame = AppState->Animation.CurrentFrame;
+	return(true);
+}
+
+// NOTE(rick): Every colour the editor makes itself is whole values from 0 to
+// 255, so rows are kept a byte per channel when they fit, which is a quarter
+// of the memory and of the time spent writing it. Anything else is kept as it
+// is in the wide bands.
+static bool32
+StoreUndoRow(struct app_state *AppState, struct undo_state *Undo, v4 *Pixels, int32 Y)
+{
+	int32 BandIndex = Y / UNDO_ROWS_PER_BAND;
+	int32 RowOffset = (Y % UNDO_ROWS_PER_BAND) * Undo->Width;
+
+	uint32 **PackedBand = Undo->PackedBands + BandIndex;
+	if(!*PackedBand)
+	{
+		*PackedBand = (uint32 *)AppState->PlatformAllocateMemory(UNDO_ROWS_PER_BAND * Undo->Width * sizeof(uint32));
+	}
+	if(*PackedBand && PackPixelRow(*PackedBand + RowOffset, Pixels, Undo->Width))
+	{
+		Undo->RowSaved[Y] = UndoRow_Packed;
+		return(true);
+	}
+
+	v4 **WideBand = Undo->WideBands + BandIndex;
+	if(!*WideBand)
+	{
+		*WideBand = (v4 *)AppState->PlatformAllocateMemory(UNDO_ROWS_PER_BAND * Undo->Width * sizeof(v4));
+	}
+	if(*WideBand)
+	{
+		// NOTE(rick): Nothing reads this back until an undo, so it goes
+		// around the cache.
+		v4 *Dest = *WideBand + RowOffset;
+		for(int32 X = 0; X < Undo->Width; ++X)
+		{
+			_mm_stream_ps(Dest[X].E, _mm_loadu_ps(Pixels[X].E));
+		}
+		Undo->RowSaved[Y] = UndoRow_Wide;
+		return(true);
+	}
+
+	Undo->RowSaved[Y] = UndoRow_None;
+	return(false);
+}
+
+static void
+LoadUndoRow(struct undo_state *Undo, v4 *Pixels, int32 Y)
+{
+	int32 BandIndex = Y / UNDO_ROWS_PER_BAND;
+	int32 RowOffset = (Y % UNDO_ROWS_PER_BAND) * Undo->Width;
+	if(Undo->RowSaved[Y] == UndoRow_Packed)
+	{
+		UnpackPixelRow(Pixels, Undo->PackedBands[BandIndex] + RowOffset, Undo->Width);
+	}
+	else
+	{
+		BlitRowCopy(Pixels, Undo->WideBands[BandIndex] + RowOffset, Undo->Width, false);
+	}
+}
+
+// NOTE(rick): An operation calls SaveUndoRow before it changes a row and
+// FinishUndoRow once it is done with it. Jobs running in parallel may call
+// both as long as no two of them share a band of UNDO_ROWS_PER_BAND rows. A
+// row that can't be saved still gets edited, the undo just won't be offered.
+static void
+SaveUndoRow(struct app_state *AppState, struct undo_state *Undo, struct pixel_buffer *Canvas, int32 Y)
+{
+	if(Undo->RowSaved && (Undo->RowSaved[Y] == UndoRow_None))
+	{
+		if(!StoreUndoRow(AppState, Undo, PixelBufferRow(Canvas, Y), Y))
+		{
+			Undo->Incomplete = true;
+		}
+	}
+}
+
+static void
+FinishUndoRow(struct undo_state *Undo, struct pixel_buffer *Canvas, int32 Y)
+{
+	if(Undo->RowSaved && Undo->RowSaved[Y])
+	{
+		Undo->RowHashes[Y] = HashPixelRow(PixelBufferRow(Canvas, Y), Canvas->Width);
+	}
+}
+
+static void
+EndUndoableEdit(struct app_state *AppState)
+{
+	struct undo_state *Undo = &AppState->Undo;
+	if(Undo->RowSaved)
+	{
+		Undo->Available = false;
+		for(int32 BandIndex = 0; BandIndex < Undo->BandCount; ++BandIndex)
+		{
+			int32 MinY = BandIndex * UNDO_ROWS_PER_BAND;
+			int32 MaxY = MinY + UNDO_ROWS_PER_BAND;
+			if(MaxY > Undo->Height) { MaxY = Undo->Height; }
+
+			bool32 PackedUsed = false;
+			bool32 WideUsed = false;
+			for(int32 Y = MinY; Y < MaxY; ++Y)
+			{
+				PackedUsed |= (Undo->RowSaved[Y] == UndoRow_Packed);
+				WideUsed |= (Undo->RowSaved[Y] == UndoRow_Wide);
+			}
+
+			if(PackedUsed || WideUsed)
+			{
+				Undo->Available = true;
+			}
+			if(!PackedUsed)
+			{
+				FreeUndoBand(AppState, (void **)(Undo->PackedBands + BandIndex));
+			}
+			if(!WideUsed)
+			{
+				FreeUndoBand(AppState, (void **)(Undo->WideBands + BandIndex));
+			}
+		}
+
+		if(Undo->Incomplete)
+		{
+			Undo->Available = false;
+		}
+	}
+}
+
+static void
+UndoLastEdit(struct app_state *AppState)
+{
+	struct undo_state *Undo = &AppState->Undo;
+	struct pixel_buffer Canvas = PixelMapBuffer(AppState);
+	if(!Undo->Available ||
+	   (Undo->Width != Canvas.Width) ||
+	   (Undo->Height != Canvas.Height) ||
+	   (Undo->Frame != AppState->Animation.CurrentFrame))
+	{
+		return;
+	}
+
+	// NOTE(rick): A row that no longer holds what the edit left has been
+	// painted over since, and undoing only the other rows would leave the
+	// canvas in a state it was never in. The undo is dropped instead.
+	for(int32 Y = 0; Y < Canvas.Height; ++Y)
+	{
+		if(Undo->RowSaved[Y] &&
+		   (HashPixelRow(PixelBufferRow(&Canvas, Y), Canvas.Width) != Undo->RowHashes[Y]))
+		{
+			FreeUndo(AppState);
+			return;
+		}
+	}
+
+	v4 *Edited = (v4 *)AppState->PlatformAllocateMemory(Canvas.Width * sizeof(v4));
+	if(!Edited)
+	{
+		return;
+	}
+
+	for(int32 Y = 0; Y < Canvas.Height; ++Y)
+	{
+		if(Undo->RowSaved[Y])
+		{
+			// NOTE(rick): The edited row goes back into the slot the original
+			// came out of, so undoing again redoes the edit. If there's no
+			// room for it the undo still completes, there's just no redo.
+			v4 *CanvasRow = PixelBufferRow(&Canvas, Y);
+			BlitRowCopy(Edited, CanvasRow, Canvas.Width, false);
+			LoadUndoRow(Undo, CanvasRow, Y);
+			if(StoreUndoRow(AppState, Undo, Edited, Y))
+			{
+				Undo->RowHashes[Y] = HashPixelRow(CanvasRow, Canvas.Width);
+			}
+			else
+			{
+				Undo->Available = false;
+			}
+		}
+	}
+
+	AppState->PlatformFreeMemory(Edited);
+}
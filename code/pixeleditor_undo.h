@@ -0,0 +1,39 @@
+#ifndef PIXEL_EDITOR_UNDO_H
+
+// NOTE(rick): A single level of undo for whole-canvas operations. Only the rows
+// an operation actually changes are copied out, and each of those rows
+// remembers a hash of what the operation left behind. Undo swaps the rows back
+// only if every one of them still holds exactly that, so later edits are never
+// thrown away and an undo never half applies; undoing again swaps them back
+// in, which makes it a redo.
+//
+// NOTE(rick): Saved rows live in bands of UNDO_ROWS_PER_BAND rows that are
+// only allocated once a row in them is saved. Bands the last edit didn't touch
+// are freed when it ends, so undo never holds more than what that edit
+// changed.
+#define UNDO_ROWS_PER_BAND 16
+
+enum undo_row_kind
+{
+	UndoRow_None,
+	UndoRow_Packed,
+	UndoRow_Wide,
+};
+
+struct undo_state
+{
+	bool32 Available;
+	bool32 Incomplete;
+	int32 Frame;
+	int32 Width;
+	int32 Height;
+	int32 BandCount;
+	uint32 **PackedBands;
+	v4 **WideBands;
+	// NOTE(rick): An undo_row_kind per row.
+	uint8 *RowSaved;
+	uint64 *RowHashes;
+};
+
+#define PIXEL_EDITOR_UNDO_H
+#endif
@@ -0,0 +1,250 @@
+static void
+FreeWrapTile(struct app_state *AppState)
+{
+	struct wrap_state *Wrap = &AppState->Wrap;
+	if(Wrap->Tile)
+	{
+		AppState->PlatformFreeMemory(Wrap->Tile);
+	}
+	if(Wrap->CellColors)
+	{
+		AppState->PlatformFreeMemory(Wrap->CellColors);
+	}
+	Wrap->Tile = 0;
+	Wrap->CellColors = 0;
+	Wrap->TileCapacity = 0;
+	Wrap->CellCapacity = 0;
+	Wrap->TileValid = false;
+}
+
+static void
+ToggleWrapMode(struct app_state *AppState)
+{
+	struct wrap_state *Wrap = &AppState->Wrap;
+	Wrap->Enabled = !Wrap->Enabled;
+	UpdateMinPixelMapZoom(AppState);
+
+	if(Wrap->Enabled)
+	{
+		// NOTE(rick): Zoom out to the repeat preview with the canvas in the
+		// middle of it.
+		AppState->PixelMapZoom = AppState->MinPixelMapZoom;
+		AppState->EditingAreaMapOffset.x = ((AppState->EditingAreaSize.x / AppState->PixelMapZoom) - AppState->PixelMapWidth) * 0.5f;
+		AppState->EditingAreaMapOffset.y = ((AppState->EditingAreaSize.y / AppState->PixelMapZoom) - AppState->PixelMapHeight) * 0.5f;
+	}
+	else
+	{
+		FreeWrapTile(AppState);
+		if(AppState->PixelMapZoom < AppState->MinPixelMapZoom)
+		{
+			AppState->PixelMapZoom = AppState->MinPixelMapZoom;
+		}
+	}
+	UpdatePixelEditorPosition(AppState, NULL);
+}
+
+static void
+DrawWrapTileCell(struct wrap_state *Wrap, int32 MapX, int32 MapY, uint32 Color)
+{
+	int32 Zoom = Wrap->TileZoom;
+	uint32 *Row = Wrap->Tile + (MapY * Zoom * Wrap->TileWidth) + (MapX * Zoom);
+	for(int32 Y = 0; Y < Zoom - 1; ++Y)
+	{
+		for(int32 X = 0; X < Zoom - 1; ++X)
+		{
+			Row[X] = Color;
+		}
+		Row[Zoom - 1] = GRID_LINE_COLOR;
+		Row += Wrap->TileWidth;
+	}
+	for(int32 X = 0; X < Zoom; ++X)
+	{
+		Row[X] = GRID_LINE_COLOR;
+	}
+}
+
+// NOTE(rick): Brings the tile up to date with the canvas. A new zoom or canvas
+// size redraws it a row of cells at a time with the zoom's cell kernel;
+// otherwise only cells whose colour changed since the last frame are
+// redrawn. Returns false when the tile can't be used at this zoom.
+static bool32
+UpdateWrapTile(struct app_state *AppState)
+{
+	struct wrap_state *Wrap = &AppState->Wrap;
+	int32 Zoom = (int32)AppState->PixelMapZoom;
+	int32 CanvasWidth = AppState->PixelMapWidth;
+	int32 CanvasHeight = AppState->PixelMapHeight;
+	if(((real32)Zoom != AppState->PixelMapZoom) || (Zoom < 2) ||
+	   (CanvasWidth > MAX_SCALED_CELLS_PER_ROW) ||
+	   (((uint64)CanvasWidth * Zoom * CanvasHeight * Zoom) > MAX_WRAP_TILE_PIXELS))
+	{
+		return(false);
+	}
+	uint32 TilePixels = (CanvasWidth * Zoom) * (CanvasHeight * Zoom);
+
+	if(!Wrap->TileValid ||
+	   (Wrap->TileZoom != Zoom) ||
+	   (Wrap->TileCanvasWidth != CanvasWidth) ||
+	   (Wrap->TileCanvasHeight != CanvasHeight))
+	{
+		uint32 CellCount = CanvasWidth * CanvasHeight;
+		if((TilePixels > Wrap->TileCapacity) || (CellCount > Wrap->CellCapacity))
+		{
+			FreeWrapTile(AppState);
+			Wrap->Tile = (uint32 *)AppState->PlatformAllocateMemory(TilePixels * sizeof(uint32));
+			Wrap->CellColors = (uint32 *)AppState->PlatformAllocateMemory(CellCount * sizeof(uint32));
+			if(!Wrap->Tile || !Wrap->CellColors)
+			{
+				FreeWrapTile(AppState);
+				return(false);
+			}
+			Wrap->TileCapacity = TilePixels;
+			Wrap->CellCapacity = CellCount;
+		}
+
+		Wrap->TileZoom = Zoom;
+		Wrap->TileCanvasWidth = CanvasWidth;
+		Wrap->TileCanvasHeight = CanvasHeight;
+		Wrap->TileWidth = CanvasWidth * Zoom;
+		Wrap->TileHeight = CanvasHeight * Zoom;
+		Wrap->TileValid = false;
+	}
+
+	bool32 DrawOnionSkin = (AppState->Animation.OnionSkinEnabled && (AppState->Animation.FrameCount > 1));
+	cell_row_scaler *ScaleCellRow = ChooseCellRowScaler(Zoom);
+	for(int32 MapY = 0; MapY < CanvasHeight; ++MapY)
+	{
+		v4 *Pixels = AppState->PixelMap + (MapY * CanvasWidth);
+		uint32 *CellColors = Wrap->CellColors + (MapY * CanvasWidth);
+		if(Wrap->TileValid)
+		{
+			for(int32 MapX = 0; MapX < CanvasWidth; ++MapX)
+			{
+				v4 Color = Pixels[MapX];
+				if(DrawOnionSkin)
+				{
+					Color = ApplyOnionSkin(AppState, MapX, MapY, Color);
+				}
+				uint32 CellColor = V4ToU32Pixel(Color);
+				if(CellColors[MapX] != CellColor)
+				{
+					CellColors[MapX] = CellColor;
+					DrawWrapTileCell(Wrap, MapX, MapY, CellColor);
+				}
+			}
+		}
+		else
+		{
+			for(int32 MapX = 0; MapX < CanvasWidth; ++MapX)
+			{
+				v4 Color = Pixels[MapX];
+				if(DrawOnionSkin)
+				{
+					Color = ApplyOnionSkin(AppState, MapX, MapY, Color);
+				}
+				CellColors[MapX] = V4ToU32Pixel(Color);
+			}
+
+			uint32 *Row = Wrap->Tile + (MapY * Zoom * Wrap->TileWidth);
+			ScaleCellRow(Row, CellColors, CanvasWidth, Zoom);
+			for(int32 Y = 1; Y < Zoom - 1; ++Y)
+			{
+				memcpy(Row + (Y * Wrap->TileWidth), Row, Wrap->TileWidth * sizeof(uint32));
+			}
+			uint32 *GridRow = Row + ((Zoom - 1) * Wrap->TileWidth);
+			for(int32 X = 0; X < Wrap->TileWidth; ++X)
+			{
+				GridRow[X] = GRID_LINE_COLOR;
+			}
+		}
+	}
+	Wrap->TileValid = true;
+
+	return(true);
+}
+
+static void
+DrawWrappedPixelMapCells(struct game_screen_buffer *Buffer, struct app_state *AppState)
+{
+	int32 MinCellX = (int32)floorf(-AppState->EditingAreaMapOffset.x);
+	int32 MinCellY = (int32)floorf(-AppState->EditingAreaMapOffset.y);
+	int32 MaxCellX = (int32)ceilf(-AppState->EditingAreaMapOffset.x + (AppState->EditingAreaSize.x / AppState->PixelMapZoom));
+	int32 MaxCellY = (int32)ceilf(-AppState->EditingAreaMapOffset.y + (AppState->EditingAreaSize.y / AppState->PixelMapZoom));
+
+	bool32 DrawOnionSkin = (AppState->Animation.OnionSkinEnabled && (AppState->Animation.FrameCount > 1));
+	for(int32 CellY = MinCellY; CellY < MaxCellY; ++CellY)
+	{
+		int32 MapY = WrapCoordinate(CellY, AppState->PixelMapHeight);
+		for(int32 CellX = MinCellX; CellX < MaxCellX; ++CellX)
+		{
+			int32 MapX = WrapCoordinate(CellX, AppState->PixelMapWidth);
+			v4 Color = AppState->PixelMap[(MapY * AppState->PixelMapWidth) + MapX];
+			if(DrawOnionSkin)
+			{
+				Color = ApplyOnionSkin(AppState, MapX, MapY, Color);
+			}
+			v2 Cell = PixelMapGridToScreen(AppState, CellX, CellY);
+			DrawRectangleWithBounds(Buffer,
+									AppState->EditingAreaOffset.x, AppState->EditingAreaOffset.x + AppState->EditingAreaSize.x,
+									AppState->EditingAreaOffset.y, AppState->EditingAreaOffset.y + AppState->EditingAreaSize.y,
+									Cell.x, Cell.y, AppState->PixelMapZoom, AppState->PixelMapZoom, Color);
+		}
+	}
+}
+
+// NOTE(rick): Fills the whole editing area with repeats of the canvas. Each
+// screen row is copied out of the tile in runs that wrap back to its left
+// edge, so the cost is one copy of the editing area however many repeats are
+// in view.
+static void
+DrawWrappedPixelMap(struct game_screen_buffer *Buffer, struct app_state *AppState)
+{
+	if(!UpdateWrapTile(AppState))
+	{
+		DrawWrappedPixelMapCells(Buffer, AppState);
+		return;
+	}
+	struct wrap_state *Wrap = &AppState->Wrap;
+
+	int32 BoundMinX = (int32)AppState->EditingAreaOffset.x;
+	int32 BoundMinY = (int32)AppState->EditingAreaOffset.y;
+	int32 BoundMaxX = (int32)(AppState->EditingAreaOffset.x + AppState->EditingAreaSize.x);
+	int32 BoundMaxY = (int32)(AppState->EditingAreaOffset.y + AppState->EditingAreaSize.y);
+	if(BoundMinX < 0) { BoundMinX = 0; }
+	if(BoundMinY < 0) { BoundMinY = 0; }
+	if(BoundMaxX > Buffer->Width) { BoundMaxX = Buffer->Width; }
+	if(BoundMaxY > Buffer->Height) { BoundMaxY = Buffer->Height; }
+	if((BoundMaxX <= BoundMinX) || (BoundMaxY <= BoundMinY))
+	{
+		return;
+	}
+
+	v2 Origin = PixelMapGridToScreen(AppState, 0, 0);
+	int32 OriginX = (int32)floorf(Origin.x);
+	int32 OriginY = (int32)floorf(Origin.y);
+	int32 FirstTileX = WrapCoordinate(BoundMinX - OriginX, Wrap->TileWidth);
+	int32 TileY = WrapCoordinate(BoundMinY - OriginY, Wrap->TileHeight);
+
+	uint8 *Base = (uint8 *)Buffer->BitmapMemory;
+	for(int32 Y = BoundMinY; Y < BoundMaxY; ++Y)
+	{
+		uint32 *Dest = (uint32 *)(Base + (Y * Buffer->Pitch)) + BoundMinX;
+		uint32 *TileRow = Wrap->Tile + (TileY * Wrap->TileWidth);
+		int32 TileX = FirstTileX;
+		int32 Remaining = BoundMaxX - BoundMinX;
+		while(Remaining > 0)
+		{
+			int32 Run = Wrap->TileWidth - TileX;
+			if(Run > Remaining) { Run = Remaining; }
+			memcpy(Dest, TileRow + TileX, Run * sizeof(uint32));
+			Dest += Run;
+			Remaining -= Run;
+			TileX = 0;
+		}
+
+		if(++TileY == Wrap->TileHeight)
+		{
+			TileY = 0;
+		}
+	}
+}
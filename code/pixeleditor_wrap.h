@@ -0,0 +1,31 @@
+#ifndef PIXEL_EDITOR_WRAP_H
+
+// NOTE(rick): How many copies of the canvas across the editing area the
+// zoom is allowed to go out to in wrap mode.
+#define WRAP_PREVIEW_REPEATS 3
+#define WRAP_MIN_ZOOM 2.0f
+// NOTE(rick): 16MB of screen pixels. Anything bigger is drawn cell by cell.
+#define MAX_WRAP_TILE_PIXELS (2048 * 2048)
+
+// NOTE(rick): Tile is the canvas drawn once at TileZoom, grid lines included,
+// and CellColors the colour each cell was drawn with. Every repeat in the
+// editing area is copied out of Tile, and only cells whose colour changed
+// are redrawn into it.
+struct wrap_state
+{
+	bool32 Enabled;
+
+	bool32 TileValid;
+	int32 TileZoom;
+	int32 TileCanvasWidth;
+	int32 TileCanvasHeight;
+	int32 TileWidth;
+	int32 TileHeight;
+	uint32 TileCapacity;
+	uint32 *Tile;
+	uint32 CellCapacity;
+	uint32 *CellColors;
+};
+
+#define PIXEL_EDITOR_WRAP_H
+#endif
@@ -1,13 +1,16 @@
 #define WIN32_LEAN_AND_MEAN
 
 #include <windows.h>
-#include <commdlg.h>
 #include <timeapi.h>
 #include "pixeleditor.cpp"
+#include "pixeleditor_timing.cpp"
 #include "win32_pixeleditor.h"
 
 static bool32 GlobalRunning;
 static struct game_screen_buffer *GlobalScreenBuffer;
+static struct frame_timing GlobalFrameTiming;
+static bool32 GlobalWriteTimingTrace;
+static struct win32_work_queue GlobalWorkQueue;
 
 static void
 Win32ResizeDIBSection(struct game_screen_buffer *Buffer, uint32 Width, uint32 Height)
@@ -64,6 +67,44 @@ Win32GetSecondsElapsed(LARGE_INTEGER Start, LARGE_INTEGER End)
 	return(Result);
 }
 
+// NOTE(rick): Message times come from the GetTickCount clock. Convert them to
+// the performance counter by backing off from now by the message's age. That
+// clock only moves once per system timer tick (timeBeginPeriod doesn't change
+// it), so the result can be off by up to a tick, typically 15.6ms; see
+// Win32GetMessageClockResolutionMS. Stamping messages as PeekMessage returns
+// them would be precise but would leave out however long they sat in the
+// queue, which is most of what input latency is.
+inline static uint64
+Win32GetMessageTimestamp(MSG *Message)
+{
+	uint64 Result = Win32GetWallClock().QuadPart;
+	DWORD AgeMS = GetTickCount() - Message->time;
+	if(AgeMS < 1000)
+	{
+		uint64 AgeTicks = ((uint64)AgeMS * GlobalFrameTiming.Frequency) / 1000;
+		if(AgeTicks < Result)
+		{
+			Result -= AgeTicks;
+		}
+	}
+	return(Result);
+}
+
+inline static real64
+Win32GetMessageClockResolutionMS()
+{
+	real64 Result = 16.0;
+	DWORD Adjustment = 0;
+	DWORD Increment = 0;
+	BOOL AdjustmentDisabled = FALSE;
+	if(GetSystemTimeAdjustment(&Adjustment, &Increment, &AdjustmentDisabled) && Increment)
+	{
+		// NOTE(rick): Increment is in 100ns units.
+		Result = (real64)Increment / 10000.0;
+	}
+	return(Result);
+}
+
 static inline struct win32_window_dimensions
 Win32GetWindowDimensions(HWND Window)
 {
@@ -128,6 +169,12 @@ Win32ProcessPendingMessages(struct app_input *Input)
 	MSG Message = {0};
 	while(PeekMessage(&Message, 0, 0, 0, PM_REMOVE))
 	{
+		if(((Message.message >= WM_KEYFIRST) && (Message.message <= WM_KEYLAST)) ||
+		   ((Message.message >= WM_MOUSEFIRST) && (Message.message <= WM_MOUSELAST)))
+		{
+			RecordInputEvent(&GlobalFrameTiming, Win32GetMessageTimestamp(&Message));
+		}
+
 		switch(Message.message)
 		{
 			case WM_SYSKEYDOWN:
@@ -138,9 +185,10 @@ Win32ProcessPendingMessages(struct app_input *Input)
 				uint32 VKCode = (uint32)Message.wParam;
 				uint32 WasDown = ((Message.lParam & (1 << 30)) != 0);
 				uint32 IsDown = ((Message.lParam & (1 << 31)) == 0);
+				bool32 ControlIsDown = ((GetKeyState(VK_CONTROL) & (1 << 15)) != 0);
 				if(IsDown != WasDown)
 				{
-					if(VKCode == 'S')
+					if((VKCode == 'S') && !ControlIsDown)
 					{
 						Win32ProcessInputMessage(&Input->ButtonSave, IsDown);
 					}
@@ -148,7 +196,7 @@ Win32ProcessPendingMessages(struct app_input *Input)
 					{
 						Win32ProcessInputMessage(&Input->ButtonReset, IsDown);
 					}
-					if(VKCode == 'E')
+					if((VKCode == 'E') && !ControlIsDown)
 					{
 						Win32ProcessInputMessage(&Input->ButtonEraser, IsDown);
 					}
@@ -184,6 +232,202 @@ Win32ProcessPendingMessages(struct app_input *Input)
 					{
 						Win32ProcessInputMessage(&Input->ButtonSize6, IsDown);
 					}
+					if(VKCode == 'B')
+					{
+						Win32ProcessInputMessage(&Input->ButtonToolPencil, IsDown);
+					}
+					if(VKCode == 'M')
+					{
+						Win32ProcessInputMessage(&Input->ButtonToolRectangleSelect, IsDown);
+					}
+					if(VKCode == 'L')
+					{
+						Win32ProcessInputMessage(&Input->ButtonToolLassoSelect, IsDown);
+					}
+					if(VKCode == 'I')
+					{
+						Win32ProcessInputMessage(&Input->ButtonToolLine, IsDown);
+					}
+					if(VKCode == 'U')
+					{
+						Win32ProcessInputMessage(&Input->ButtonToolRectangle, IsDown);
+					}
+					if(VKCode == 'Y')
+					{
+						Win32ProcessInputMessage(&Input->ButtonToolEllipse, IsDown);
+					}
+					if(VKCode == 'F')
+					{
+						Win32ProcessInputMessage(&Input->ButtonToggleShapeFill, IsDown);
+					}
+					if(VKCode == 'G')
+					{
+						Win32ProcessInputMessage(&Input->ButtonToolGradient, IsDown);
+					}
+					if(VKCode == 'D')
+					{
+						Win32ProcessInputMessage(&Input->ButtonToggleGradientDither, IsDown);
+					}
+					if(VKCode == 'K')
+					{
+						Win32ProcessInputMessage(&Input->ButtonCycleGradientSteps, IsDown);
+					}
+					if(VKCode == 'W')
+					{
+						Win32ProcessInputMessage(&Input->ButtonReplaceColor, IsDown);
+					}
+					if((VKCode == 'A') && !ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonSwapPalette, IsDown);
+					}
+					if(VKCode == 'T')
+					{
+						Win32ProcessInputMessage(&Input->ButtonCycleTolerance, IsDown);
+					}
+					if((VKCode == 'Z') && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonUndo, IsDown);
+					}
+					if((VKCode == 'V') && !ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonToolMove, IsDown);
+					}
+					if((VKCode == 'C') && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonCopy, IsDown);
+					}
+					if((VKCode == 'X') && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonCut, IsDown);
+					}
+					if((VKCode == 'X') && !ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonToggleWrap, IsDown);
+					}
+					if((VKCode == 'V') && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonPaste, IsDown);
+					}
+					if((VKCode == VK_DELETE) && !ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonDelete, IsDown);
+					}
+					if((VKCode == VK_RETURN) || (VKCode == VK_ESCAPE))
+					{
+						Win32ProcessInputMessage(&Input->ButtonDeselect, IsDown);
+					}
+					if(VKCode == VK_OEM_6)
+					{
+						Win32ProcessInputMessage(&Input->ButtonRotateClockwise, IsDown);
+					}
+					if(VKCode == VK_OEM_4)
+					{
+						Win32ProcessInputMessage(&Input->ButtonRotateCounterClockwise, IsDown);
+					}
+					if(VKCode == VK_OEM_5)
+					{
+						Win32ProcessInputMessage(&Input->ButtonRotateHalf, IsDown);
+					}
+					if(VKCode == 'H')
+					{
+						Win32ProcessInputMessage(&Input->ButtonFlipHorizontal, IsDown);
+					}
+					if(VKCode == 'J')
+					{
+						Win32ProcessInputMessage(&Input->ButtonFlipVertical, IsDown);
+					}
+					if((VKCode == VK_OEM_PLUS) && !ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonScaleUp, IsDown);
+					}
+					if((VKCode == VK_OEM_MINUS) && !ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonScaleDown, IsDown);
+					}
+					if(VKCode == 'N')
+					{
+						Win32ProcessInputMessage(&Input->ButtonAddFrame, IsDown);
+					}
+					if((VKCode == VK_DELETE) && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonDeleteFrame, IsDown);
+					}
+					if(VKCode == VK_OEM_COMMA)
+					{
+						Win32ProcessInputMessage(&Input->ButtonPreviousFrame, IsDown);
+					}
+					if(VKCode == VK_OEM_PERIOD)
+					{
+						Win32ProcessInputMessage(&Input->ButtonNextFrame, IsDown);
+					}
+					if(VKCode == VK_SPACE)
+					{
+						Win32ProcessInputMessage(&Input->ButtonPlayAnimation, IsDown);
+					}
+					if((VKCode == 'O') && !ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonOnionSkin, IsDown);
+					}
+					if((VKCode == VK_PRIOR) && !ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonIncreaseFPS, IsDown);
+					}
+					if((VKCode == VK_NEXT) && !ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonDecreaseFPS, IsDown);
+					}
+					if((VKCode == 'O') && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonLoadReference, IsDown);
+					}
+					if((VKCode == 'Z') && !ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonCycleReferenceMode, IsDown);
+					}
+					if((VKCode == VK_PRIOR) && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonReferenceOpacityUp, IsDown);
+					}
+					if((VKCode == VK_NEXT) && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonReferenceOpacityDown, IsDown);
+					}
+					if((VKCode == VK_OEM_PLUS) && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonReferenceScaleUp, IsDown);
+					}
+					if((VKCode == VK_OEM_MINUS) && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonReferenceScaleDown, IsDown);
+					}
+					if(VKCode == VK_LEFT)
+					{
+						Win32ProcessInputMessage(&Input->ButtonReferenceLeft, IsDown);
+					}
+					if(VKCode == VK_RIGHT)
+					{
+						Win32ProcessInputMessage(&Input->ButtonReferenceRight, IsDown);
+					}
+					if(VKCode == VK_UP)
+					{
+						Win32ProcessInputMessage(&Input->ButtonReferenceUp, IsDown);
+					}
+					if(VKCode == VK_DOWN)
+					{
+						Win32ProcessInputMessage(&Input->ButtonReferenceDown, IsDown);
+					}
+					if((VKCode == 'S') && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonExportSpriteSheet, IsDown);
+					}
+					if((VKCode == 'E') && ControlIsDown)
+					{
+						Win32ProcessInputMessage(&Input->ButtonExportScaled, IsDown);
+					}
+					if((VKCode == VK_F12) && IsDown)
+					{
+						GlobalWriteTimingTrace = true;
+					}
 				}
 			} break;
 			case WM_MOUSEWHEEL:
@@ -200,6 +444,76 @@ Win32ProcessPendingMessages(struct app_input *Input)
 	}
 }
 
+PLATFORM_READ_ENTIRE_FILE(Win32ReadEntireFile)
+{
+	struct platform_file_contents Result = {0};
+
+	HANDLE File = CreateFileA(Filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, 0, 0);
+	if(File != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER FileSize = {0};
+		if(GetFileSizeEx(File, &FileSize) && (FileSize.QuadPart > 0) && (FileSize.QuadPart <= 0xFFFFFFFF))
+		{
+			uint32 Size = (uint32)FileSize.QuadPart;
+			void *Data = VirtualAlloc(0, Size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+			if(Data)
+			{
+				DWORD BytesRead = 0;
+				if(ReadFile(File, Data, Size, &BytesRead, 0) && (BytesRead == Size))
+				{
+					Result.Data = Data;
+					Result.Size = Size;
+				}
+				else
+				{
+					VirtualFree(Data, 0, MEM_RELEASE);
+				}
+			}
+		}
+
+		CloseHandle(File);
+	}
+
+	return(Result);
+}
+
+PLATFORM_MAP_FILE(Win32MapFile)
+{
+	struct platform_file_contents Result = {0};
+
+	HANDLE File = CreateFileA(Filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, 0, 0);
+	if(File != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER FileSize = {0};
+		if(GetFileSizeEx(File, &FileSize) && (FileSize.QuadPart > 0) && (FileSize.QuadPart <= 0xFFFFFFFF))
+		{
+			HANDLE Mapping = CreateFileMappingA(File, 0, PAGE_READONLY, 0, 0, 0);
+			if(Mapping)
+			{
+				// NOTE(rick): The view keeps the mapping alive on its own.
+				Result.Data = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+				if(Result.Data)
+				{
+					Result.Size = (uint32)FileSize.QuadPart;
+				}
+				CloseHandle(Mapping);
+			}
+		}
+
+		CloseHandle(File);
+	}
+
+	return(Result);
+}
+
+PLATFORM_UNMAP_FILE(Win32UnmapFile)
+{
+	if(Memory)
+	{
+		UnmapViewOfFile(Memory);
+	}
+}
+
 PLATFORM_WRITE_FILE(Win32WriteFile)
 {
 	bool32 Result = false;
@@ -222,6 +536,74 @@ PLATFORM_WRITE_FILE(Win32WriteFile)
 	return(Result);
 }
 
+PLATFORM_WRITE_FILE_RANGES(Win32WriteFileRanges)
+{
+	bool32 Result = false;
+
+	HANDLE File = CreateFileA(Filename, GENERIC_WRITE, 0, 0, OPEN_EXISTING, 0, 0);
+	if(File != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER FileSize = {0};
+		if(GetFileSizeEx(File, &FileSize) && ((uint64)FileSize.QuadPart == ExpectedFileSize))
+		{
+			Result = true;
+			for(uint32 RangeIndex = 0; RangeIndex < RangeCount; ++RangeIndex)
+			{
+				struct platform_file_range *Range = Ranges + RangeIndex;
+				LARGE_INTEGER Offset = {0};
+				Offset.QuadPart = Range->Offset;
+				DWORD BytesWritten = 0;
+				if(!SetFilePointerEx(File, Offset, 0, FILE_BEGIN) ||
+				   !WriteFile(File, Range->Data, Range->Size, &BytesWritten, 0) ||
+				   (BytesWritten != Range->Size))
+				{
+					Result = false;
+					break;
+				}
+			}
+		}
+
+		CloseHandle(File);
+	}
+
+	return(Result);
+}
+
+PLATFORM_BEGIN_WRITE_FILE(Win32BeginWriteFile)
+{
+	void *Result = 0;
+
+	HANDLE File = CreateFileA(Filename, GENERIC_WRITE, 0, 0, CREATE_ALWAYS, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+	if(File != INVALID_HANDLE_VALUE)
+	{
+		Result = (void *)File;
+	}
+
+	return(Result);
+}
+
+PLATFORM_APPEND_TO_FILE(Win32AppendToFile)
+{
+	bool32 Result = false;
+
+	DWORD BytesWritten = 0;
+	if(WriteFile((HANDLE)File, Data, Size, &BytesWritten, 0))
+	{
+		if(BytesWritten == Size)
+		{
+			Result = true;
+		}
+	}
+
+	return(Result);
+}
+
+PLATFORM_END_WRITE_FILE(Win32EndWriteFile)
+{
+	bool32 Result = (CloseHandle((HANDLE)File) != 0);
+	return(Result);
+}
+
 PLATFORM_ALLOCATE_MEMORY(Win32AllocateMemory)
 {
 	void *Result = VirtualAlloc(0, Size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
@@ -236,6 +618,102 @@ PLATFORM_FREE_MEMORY(Win32FreeMemory)
 	}
 }
 
+static void
+Win32DoQueuedJobs(struct win32_work_queue *Queue)
+{
+	for(;;)
+	{
+		LONG JobIndex = InterlockedIncrement(&Queue->NextJob) - 1;
+		if(JobIndex >= Queue->JobCount)
+		{
+			break;
+		}
+
+		Queue->Callback(Queue->Context, (uint32)JobIndex);
+		InterlockedIncrement(&Queue->CompletedJobs);
+	}
+}
+
+static DWORD WINAPI
+Win32WorkerThreadProc(LPVOID Parameter)
+{
+	struct win32_work_queue *Queue = (struct win32_work_queue *)Parameter;
+	for(;;)
+	{
+		WaitForSingleObjectEx(Queue->Semaphore, INFINITE, FALSE);
+		Win32DoQueuedJobs(Queue);
+		InterlockedIncrement(&Queue->WorkersCheckedIn);
+	}
+}
+
+static void
+Win32InitializeWorkQueue(struct win32_work_queue *Queue)
+{
+	SYSTEM_INFO SystemInfo = {0};
+	GetSystemInfo(&SystemInfo);
+
+	uint32 WorkerCount = 0;
+	if(SystemInfo.dwNumberOfProcessors > 1)
+	{
+		WorkerCount = SystemInfo.dwNumberOfProcessors - 1;
+	}
+	if(WorkerCount > WIN32_MAX_WORKER_THREADS)
+	{
+		WorkerCount = WIN32_MAX_WORKER_THREADS;
+	}
+
+	Queue->NextJob = 0;
+	Queue->JobCount = 0;
+	Queue->Semaphore = CreateSemaphoreEx(0, 0, WorkerCount ? WorkerCount : 1, 0, 0, SEMAPHORE_ALL_ACCESS);
+	if(Queue->Semaphore)
+	{
+		for(uint32 WorkerIndex = 0; WorkerIndex < WorkerCount; ++WorkerIndex)
+		{
+			HANDLE Thread = CreateThread(0, 0, Win32WorkerThreadProc, Queue, 0, 0);
+			if(!Thread)
+			{
+				break;
+			}
+			CloseHandle(Thread);
+			++Queue->WorkerCount;
+		}
+	}
+}
+
+PLATFORM_RUN_PARALLEL(Win32RunParallel)
+{
+	struct win32_work_queue *Queue = &GlobalWorkQueue;
+	uint32 WorkersToWake = JobCount - 1;
+	if(WorkersToWake > Queue->WorkerCount)
+	{
+		WorkersToWake = Queue->WorkerCount;
+	}
+
+	if(WorkersToWake == 0)
+	{
+		for(uint32 JobIndex = 0; JobIndex < JobCount; ++JobIndex)
+		{
+			Callback(Context, JobIndex);
+		}
+		return;
+	}
+
+	Queue->Callback = Callback;
+	Queue->Context = Context;
+	Queue->JobCount = (LONG)JobCount;
+	Queue->CompletedJobs = 0;
+	Queue->WorkersCheckedIn = 0;
+	InterlockedExchange(&Queue->NextJob, 0);
+	ReleaseSemaphore(Queue->Semaphore, WorkersToWake, 0);
+
+	Win32DoQueuedJobs(Queue);
+	while((Queue->CompletedJobs < (LONG)JobCount) ||
+		  (Queue->WorkersCheckedIn < (LONG)WorkersToWake))
+	{
+		YieldProcessor();
+	}
+}
+
 int WINAPI
 WinMain(HINSTANCE Instance, HINSTANCE PrevInstance, LPSTR CmdLine, int CmdShow)
 {
@@ -254,7 +732,7 @@ WinMain(HINSTANCE Instance, HINSTANCE PrevInstance, LPSTR CmdLine, int CmdShow)
 	}
 
 	int WindowWidth = 860;
-	int WindowHeight = 860;
+	int WindowHeight = 900;
 	HWND Window = CreateWindowEx(0,
 								 WindowClass.lpszClassName,
 								 "Pixel Editor",
@@ -280,21 +758,43 @@ WinMain(HINSTANCE Instance, HINSTANCE PrevInstance, LPSTR CmdLine, int CmdShow)
 	struct app_input *OldInput = &Input[1];
 
 	struct app_state AppState = {0};
+	AppState.PlatformReadEntireFile = Win32ReadEntireFile;
+	AppState.PlatformMapFile = Win32MapFile;
+	AppState.PlatformUnmapFile = Win32UnmapFile;
 	AppState.PlatformWriteFile = Win32WriteFile;
+	AppState.PlatformWriteFileRanges = Win32WriteFileRanges;
+	AppState.PlatformBeginWriteFile = Win32BeginWriteFile;
+	AppState.PlatformAppendToFile = Win32AppendToFile;
+	AppState.PlatformEndWriteFile = Win32EndWriteFile;
 	AppState.PlatformAllocateMemory = Win32AllocateMemory;
 	AppState.PlatformFreeMemory = Win32FreeMemory;
 
-	COLORREF CustomColors[16] = {0};
+	Win32InitializeWorkQueue(&GlobalWorkQueue);
+	if(GlobalWorkQueue.WorkerCount > 0)
+	{
+		AppState.PlatformRunParallel = Win32RunParallel;
+	}
+
+	LARGE_INTEGER PerformanceFrequency = {0};
+	QueryPerformanceFrequency(&PerformanceFrequency);
+	GlobalFrameTiming.Frequency = PerformanceFrequency.QuadPart;
+	GlobalFrameTiming.InputClockResolutionMS = Win32GetMessageClockResolutionMS();
+
 	GlobalRunning = true;
 	real32 TargetFPS = 60.0f;
 	real32 TargetSecondsPerFrame = 1.0f / TargetFPS;
 	real32 TargetMSPerFrame = TargetSecondsPerFrame * 1000.0f;
+	real32 LastFrameMS = 0.0f;
+	real32 LastUpdateMS = 0.0f;
 	while(GlobalRunning)
 	{
 		LARGE_INTEGER StartTime = Win32GetWallClock();
+		BeginFrameTiming(&GlobalFrameTiming, StartTime.QuadPart);
 
 		*NewInput = {0};
 		NewInput->dtForFrame = TargetSecondsPerFrame;
+		NewInput->LastFrameMS = LastFrameMS;
+		NewInput->LastUpdateMS = LastUpdateMS;
 		NewInput->LastMouseX = OldInput->MouseX;
 		NewInput->LastMouseY = OldInput->MouseY;
 		for(uint32 ButtonIndex = 0;
@@ -314,43 +814,19 @@ WinMain(HINSTANCE Instance, HINSTANCE PrevInstance, LPSTR CmdLine, int CmdShow)
 		Win32ProcessInputMessage(&NewInput->ButtonPrimary, (GetKeyState(VK_LBUTTON) & (1 << 15)));
 		Win32ProcessInputMessage(&NewInput->ButtonSecondary, (GetKeyState(VK_RBUTTON) & (1 << 15)));
 
+		LARGE_INTEGER UpdateStartTime = Win32GetWallClock();
+		MarkFrameStage(&GlobalFrameTiming, FrameStage_UpdateAndRender, UpdateStartTime.QuadPart);
 		EditorUpdateAndRender(&AppState, &ScreenBuffer, NewInput);
+		LastUpdateMS = Win32GetSecondsElapsed(UpdateStartTime, Win32GetWallClock()) * 1000.0f;
 
-		if(AppState.ColorPickerButtonClicked)
-		{
-			CHOOSECOLOR ChosenColor = {0};
-			ChosenColor.lStructSize = sizeof(ChosenColor);
-			ChosenColor.lpCustColors = CustomColors;
-			ChosenColor.rgbResult = RGB(AppState.PixelColor.r, AppState.PixelColor.g, AppState.PixelColor.b);
-			ChosenColor.Flags = CC_FULLOPEN | CC_RGBINIT;
-			bool32 ColorPicked = ChooseColor(&ChosenColor);
-			if(ColorPicked)
-			{
-				AppState.PixelColor = V4(GetRValue(ChosenColor.rgbResult),
-										 GetGValue(ChosenColor.rgbResult),
-										 GetBValue(ChosenColor.rgbResult),
-										 0xff);
-				if(AppState.CustomColorButtons)
-				{
-					for(int32 CustomColorIndex = 0;
-						CustomColorIndex < ArrayCount(CustomColors);
-						++CustomColorIndex)
-					{
-						COLORREF CustomColor = CustomColors[CustomColorIndex];
-						AppState.CustomColorButtons[CustomColorIndex].Color = V4(GetRValue(CustomColor),
-																				 GetGValue(CustomColor),
-																				 GetBValue(CustomColor),
-																				 0xff);
-					}
-				}
-			}
-			AppState.ColorPickerButtonClicked = false;
-		}
-
+		MarkFrameStage(&GlobalFrameTiming, FrameStage_Present, Win32GetWallClock().QuadPart);
 		HDC DeviceContext = GetDC(Window);
 		struct win32_window_dimensions WindowDims = Win32GetWindowDimensions(Window);
 		Win32DrawScreenBufferToWindow(DeviceContext, &ScreenBuffer, 0, 0, WindowDims.Width, WindowDims.Height);
 		ReleaseDC(Window, DeviceContext);
+		LARGE_INTEGER PresentTime = Win32GetWallClock();
+		MarkFramePresented(&GlobalFrameTiming, PresentTime.QuadPart);
+		MarkFrameStage(&GlobalFrameTiming, FrameStage_Wait, PresentTime.QuadPart);
 
 		struct app_input *TempInput = NewInput;
 		NewInput = OldInput;
@@ -374,7 +850,24 @@ WinMain(HINSTANCE Instance, HINSTANCE PrevInstance, LPSTR CmdLine, int CmdShow)
 			OutputDebugStringA(FPSBuffer);
 #endif
 		}
+
+		LARGE_INTEGER FrameEndTime = Win32GetWallClock();
+		EndFrameTiming(&GlobalFrameTiming, FrameEndTime.QuadPart);
+		LastFrameMS = Win32GetSecondsElapsed(StartTime, FrameEndTime) * 1000.0f;
+		if(GlobalWriteTimingTrace)
+		{
+			char Summary[256] = {0};
+			FormatTimingSummary(&GlobalFrameTiming, Summary, sizeof(Summary));
+			OutputDebugStringA(Summary);
+			WriteFrameTimingTrace(&GlobalFrameTiming, "FrameTiming.json",
+								  Win32AllocateMemory, Win32WriteFile, Win32FreeMemory);
+			GlobalWriteTimingTrace = false;
+		}
 	}
 
+	WriteFrameTimingTrace(&GlobalFrameTiming, "FrameTiming.json",
+						  Win32AllocateMemory, Win32WriteFile, Win32FreeMemory);
+	WriteSessionSnapshot(&AppState, SESSION_FILENAME);
+
 	return 0;
 }
@@ -6,5 +6,23 @@ struct win32_window_dimensions
 	uint32 Height;
 };
 
+#define WIN32_MAX_WORKER_THREADS 15
+
+// NOTE(rick): One batch of jobs at a time. Jobs are handed out by bumping
+// NextJob; the thread calling RunParallel works on the batch too and waits for
+// every worker it woke to check back in before the queue is reused.
+struct win32_work_queue
+{
+	HANDLE Semaphore;
+	uint32 WorkerCount;
+
+	platform_work_callback *Callback;
+	void *Context;
+	LONG JobCount;
+	volatile LONG NextJob;
+	volatile LONG CompletedJobs;
+	volatile LONG WorkersCheckedIn;
+};
+
 #define WIN32_PIXEL_EDITOR_H
 #endif